@@ -0,0 +1,119 @@
+// Load generator for EngineHost: concurrent sessions play random-vs-engine
+// games and every engine move's latency is recorded.
+// Usage: bench_host [sessions] [time_ms] [moves_per_session] [deadline_ms] [book.ogm]
+#include "board.hpp"
+#include "engineHost.hpp"
+#include "openingBook.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+struct Stats {
+    std::vector<double> latency_ms; // searched moves only
+    int ok = 0, book = 0, rejected = 0, expired = 0;
+    int slot_waits = 0; // open_session refused: all tables in use
+};
+
+static double percentile(std::vector<double>& values, double p) {
+    if (values.empty()) return 0;
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static void client(EngineHost& host, int id, int time_ms, int moves, int deadline_ms, Stats& stats, std::mutex& lock) {
+    std::mt19937_64 rng(id + 1);
+    Stats local;
+
+    int session = host.open_session();
+    while (session < 0) { // admission control: wait for a free table
+        ++local.slot_waits;
+        std::this_thread::sleep_for(milliseconds(10));
+        session = host.open_session();
+    }
+
+    Board board;
+    bool is_black = true;
+    const bool engine_black = id % 2 == 0;
+    for (int played = 0; played < moves; ) {
+        if (board.is_game_over()) {
+            board = Board();
+            is_black = true;
+        }
+        auto legal = board.get_moves(is_black);
+        if (legal.empty()) {
+            is_black = !is_black;
+            continue;
+        }
+
+        uint64_t move = legal[rng() % legal.size()];
+        if (is_black == engine_black) {
+            const auto start = steady_clock::now();
+            MoveReply reply = host.request_move(session, board, is_black, time_ms, start + milliseconds(deadline_ms)).get();
+            const double ms = duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0;
+
+            switch (reply.status) {
+                case REQUEST_OK: ++local.ok; local.latency_ms.push_back(ms); move = reply.result.move; break;
+                case REQUEST_BOOK: ++local.book; move = reply.result.move; break;
+                case REQUEST_REJECTED: ++local.rejected; break;
+                case REQUEST_EXPIRED: ++local.expired; break;
+            }
+            ++played;
+        }
+        board.make_move(move, is_black);
+        is_black = !is_black;
+    }
+    host.close_session(session);
+
+    std::lock_guard<std::mutex> guard(lock);
+    stats.latency_ms.insert(stats.latency_ms.end(), local.latency_ms.begin(), local.latency_ms.end());
+    stats.ok += local.ok;
+    stats.book += local.book;
+    stats.rejected += local.rejected;
+    stats.expired += local.expired;
+    stats.slot_waits += local.slot_waits;
+}
+
+int main(int argc, char** argv) {
+    const int sessions = argc > 1 ? std::atoi(argv[1]) : 16;
+    const int time_ms = argc > 2 ? std::atoi(argv[2]) : 20;
+    const int moves = argc > 3 ? std::atoi(argv[3]) : 30;
+    const int deadline_ms = argc > 4 ? std::atoi(argv[4]) : 1000;
+
+    OpeningBook book;
+    if (argc > 5 && !book.load_games(argv[5])) {
+        fprintf(stderr, "Cannot read book %s\n", argv[5]);
+        return 1;
+    }
+
+    EngineHostConfig config;
+    config.max_sessions = std::max(1, sessions / 2); // half the clients wait for a table at first
+    EngineHost host(config, &book);
+
+    Stats stats;
+    std::mutex lock;
+    const auto start = steady_clock::now();
+    std::vector<std::thread> clients;
+    for (int i = 0; i < sessions; ++i) {
+        clients.emplace_back(client, std::ref(host), i, time_ms, moves, deadline_ms, std::ref(stats), std::ref(lock));
+    }
+    for (auto& thread : clients) thread.join();
+    const double seconds = duration_cast<milliseconds>(steady_clock::now() - start).count() / 1000.0;
+
+    const size_t searched = stats.latency_ms.size();
+    printf("%d clients, %zu session slots, %u workers, %d ms/move, %d ms deadline, book %zu positions\n",
+           sessions, config.max_sessions, std::max(1u, std::thread::hardware_concurrency()), time_ms, deadline_ms, book.size());
+    printf("searched %d  book %d  rejected %d  expired %d  session waits %d   %.1f moves/s\n",
+           stats.ok, stats.book, stats.rejected, stats.expired, stats.slot_waits, (stats.ok + stats.book) / seconds);
+    printf("latency ms: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+           percentile(stats.latency_ms, 0.50), percentile(stats.latency_ms, 0.90),
+           percentile(stats.latency_ms, 0.99), searched ? *std::max_element(stats.latency_ms.begin(), stats.latency_ms.end()) : 0.0);
+    return 0;
+}
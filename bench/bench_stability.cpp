@@ -0,0 +1,53 @@
+// Microbenchmark for the stable-disc kernel on positions from random games
+#include "board.hpp"
+#include "evaluation.hpp"
+#include "stability.hpp"
+#include "tests/check.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace std::chrono;
+
+static std::vector<Board> sample_positions(size_t count) {
+    std::mt19937_64 rng(42);
+    std::vector<Board> positions;
+    positions.reserve(count);
+    while (positions.size() < count) {
+        random_game(rng, [&](const Board& board, bool) {
+            positions.push_back(board);
+            return positions.size() < count;
+        });
+    }
+    return positions;
+}
+
+template<typename F>
+static void run(const char* name, const std::vector<Board>& positions, F&& kernel) {
+    const int ROUNDS = 20;
+    uint64_t sink = 0;
+    auto start = steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (const Board& board : positions) sink += kernel(board);
+    }
+    const double ns = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    printf("%-22s %8.1f ns/position   (checksum %llu)\n", name, ns / (ROUNDS * positions.size()),
+           static_cast<unsigned long long>(sink));
+}
+
+int main() {
+    const auto positions = sample_positions(200000);
+
+    run("full_lines", positions, [](const Board& b) {
+        auto full = Stability::full_lines(b.black | b.white);
+        return full.horizontal ^ full.vertical ^ full.diagonal ^ full.anti_diagonal;
+    });
+    run("stable_discs (both)", positions, [](const Board& b) {
+        return Stability::stable_discs(b.black, b.white) ^ Stability::stable_discs(b.white, b.black);
+    });
+    run("evaluate", positions, [](const Board& b) {
+        return static_cast<uint64_t>(evaluate(b));
+    });
+    return 0;
+}
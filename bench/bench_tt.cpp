@@ -0,0 +1,88 @@
+// Transposition table probe latency and clear time, huge pages vs regular pages.
+// Usage: bench_tt [size_mb]   (default 1024)
+#include "transPositionTable.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace std::chrono;
+
+static uint64_t splitmix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Huge pages backing this process, from /proc/self/smaps_rollup
+static long huge_page_kb() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string key;
+    std::getline(smaps, key); // address range header
+    long kb = 0, value;
+    while (smaps >> key >> value) {
+        if (key == "AnonHugePages:" || key == "Private_Hugetlb:") kb += value;
+        smaps.ignore(256, '\n');
+    }
+    return kb;
+}
+
+template<typename F>
+static double time_ms(F&& f) {
+    auto start = steady_clock::now();
+    f();
+    return duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0;
+}
+
+static void run(size_t size_mb, bool huge_pages) {
+    TTConfig config;
+    config.size_mb = size_mb;
+    config.huge_pages = huge_pages;
+    config.clear_threads = 1;
+    TranspositionTable tt(config);
+
+    const double first_clear = time_ms([&] { tt.clear(); }); // includes page faults
+    const double clear_1 = time_ms([&] { tt.clear(); });
+
+    config.clear_threads = 0;
+    TranspositionTable tt_parallel(config);
+    tt_parallel.clear();
+    const double clear_n = time_ms([&] { tt_parallel.clear(); });
+
+    // Fill, storing a random follow-up hash as the best move
+    const size_t entries = tt.size();
+    uint64_t h = 1;
+    for (size_t i = 0; i < entries; ++i) {
+        h = splitmix(h);
+        tt.store(h, 1 + i % 20, 0, EXACT, splitmix(h ^ 0x5555));
+    }
+
+    // Dependent chain: each probe address comes from the previous probe's result
+    const size_t PROBES = 5000000;
+    uint64_t hash = 12345;
+    const double chain_ms = time_ms([&] {
+        for (size_t i = 0; i < PROBES; ++i) hash = splitmix(hash ^ tt.best_move(hash));
+    });
+
+    // Independent probes: measures throughput with memory-level parallelism
+    uint64_t sink = 0;
+    const double indep_ms = time_ms([&] {
+        for (size_t i = 0; i < PROBES; ++i) sink += tt.best_move(splitmix(i));
+    });
+
+    printf("%-8s %5zu MB  huge=%d (%6ld MB backed)  first clear %8.1f ms  clear x1 %7.1f ms  "
+           "clear x%u %7.1f ms  latency %6.1f ns  throughput %6.1f ns/probe  [%llx]\n",
+           huge_pages ? "huge" : "regular", tt.memory_bytes() >> 20, tt.uses_huge_pages(), huge_page_kb() >> 10,
+           first_clear, clear_1, std::max(1u, std::thread::hardware_concurrency()), clear_n,
+           chain_ms * 1e6 / PROBES, indep_ms * 1e6 / PROBES, static_cast<unsigned long long>(hash ^ sink));
+}
+
+int main(int argc, char** argv) {
+    const size_t size_mb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024;
+    run(size_mb, false);
+    run(size_mb, true);
+    return 0;
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "tables.hpp"
 #include <sys/types.h>
 #include <vector>
 #include <iostream>
+#include <string>
 #include <cstdint> 
 
 using std::vector;
@@ -51,34 +53,97 @@ struct Board {
 
     // get all possible moves for a player
     vector<uint64_t> get_moves(bool is_black) const {
+        vector<uint64_t> moves;
+        uint64_t mask = get_move_mask(is_black);
+        while (mask) {
+            uint64_t move = mask & -mask;
+            moves.push_back(move);
+            mask ^= move;
+        }
+        return moves;
+    }
+
+    // all legal moves for a player as one bitboard
+    uint64_t get_move_mask(bool is_black) const {
         uint64_t player = is_black ? black : white;
         uint64_t opponent = is_black ? white : black;
-
-        vector<uint64_t> moves;
         uint64_t empty = ~(player | opponent);
 
-        for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; ++i) {
-            uint64_t mask = 1ULL << i;
-            if (empty & mask && is_valid_move(mask, is_black)) {
-                moves.push_back(mask);
+        uint64_t moves = 0;
+        for (int dir = 0; dir < 8; ++dir) {
+            uint64_t run = shift(player, dir) & opponent;
+            while (run) {
+                uint64_t next = shift(run, dir);
+                moves |= next & empty;
+                run = next & opponent;
             }
         }
         return moves;
     }
 
-    static uint64_t shift(uint64_t mask, int dir) {
-        switch (dir) {
-            // Fixed directions
-            case 0: return (mask >> 8) & 0x00FFFFFFFFFFFFFF; // Up 
-            case 1: return (mask << 8) & 0xFFFFFFFFFFFFFF00; // Down 
-            case 2: return (mask & 0x7F7F7F7F7F7F7F7F) << 1;  // Right
-            case 3: return (mask & 0xFEFEFEFEFEFEFEFE) >> 1;  // Left
-            case 4: return (mask & 0xFEFEFEFEFEFEFEFE) >> 9;  // Up-Left
-            case 5: return (mask & 0x7F7F7F7F7F7F7F7F) >> 7;  // Up-Right
-            case 6: return (mask & 0xFEFEFEFEFEFEFEFE) << 7;  // Down-Left
-            case 7: return (mask & 0x7F7F7F7F7F7F7F7F) << 9;  // Down-Right
-            default: return 0;
+    // dir: 0 up, 1 down, 2 right, 3 left, 4 up-left, 5 up-right, 6 down-left, 7 down-right
+    static constexpr uint64_t shift(uint64_t mask, int dir) {
+        return Tables::shift(mask, dir);
+    }
+
+    // Discs flipped along one direction when playing square sq
+    static uint64_t ray_flips(int sq, int dir, uint64_t player, uint64_t opponent) {
+        const uint64_t ray = Tables::RAYS[dir][sq];
+        const uint64_t blockers = ray & ~opponent;
+        if (!blockers) return 0;
+
+        uint64_t first, between;
+        if (Tables::is_increasing(dir)) {
+            first = blockers & -blockers;
+            between = ray & (first - 1);
+        } else {
+            first = 1ULL << (63 - __builtin_clzll(blockers));
+            between = ray & ~((first << 1) - 1);
         }
+        return (first & player) ? between : 0;
+    }
+
+
+    // Board symmetries (bit 0 = a1, bit 63 = h8)
+    static uint64_t flip_vertical(uint64_t x) {
+        return __builtin_bswap64(x);
+    }
+
+    static uint64_t mirror_horizontal(uint64_t x) {
+        const uint64_t k1 = 0x5555555555555555ULL;
+        const uint64_t k2 = 0x3333333333333333ULL;
+        const uint64_t k4 = 0x0F0F0F0F0F0F0F0FULL;
+        x = ((x >> 1) & k1) | ((x & k1) << 1);
+        x = ((x >> 2) & k2) | ((x & k2) << 2);
+        x = ((x >> 4) & k4) | ((x & k4) << 4);
+        return x;
+    }
+
+    static uint64_t flip_diagonal(uint64_t x) { // mirror along a1-h8
+        const uint64_t k1 = 0x5500550055005500ULL;
+        const uint64_t k2 = 0x3333000033330000ULL;
+        const uint64_t k4 = 0x0F0F0F0F00000000ULL;
+        uint64_t t;
+        t = k4 & (x ^ (x << 28)); x ^= t ^ (t >> 28);
+        t = k2 & (x ^ (x << 14)); x ^= t ^ (t >> 14);
+        t = k1 & (x ^ (x << 7));  x ^= t ^ (t >> 7);
+        return x;
+    }
+
+    // sym in [0, 8): bit 2 = diagonal, bit 1 = vertical, bit 0 = horizontal
+    static uint64_t transform(uint64_t x, int sym) {
+        if (sym & 4) x = flip_diagonal(x);
+        if (sym & 2) x = flip_vertical(x);
+        if (sym & 1) x = mirror_horizontal(x);
+        return x;
+    }
+
+    // Each step is its own inverse, so undo them in reverse order
+    static uint64_t inverse_transform(uint64_t x, int sym) {
+        if (sym & 1) x = mirror_horizontal(x);
+        if (sym & 2) x = flip_vertical(x);
+        if (sym & 4) x = flip_diagonal(x);
+        return x;
     }
 
 
@@ -86,17 +151,11 @@ struct Board {
         uint64_t player = is_black ? black : white;
         uint64_t opponent = is_black ? white : black;
 
-        for (int dir = 0; dir < BOARD_SIZE; ++dir) {
-            uint64_t mask = move;
-            uint64_t flipped = 0;
-            mask = shift(mask, dir);
-
-            while(mask && (mask & opponent)) {
-                flipped |= mask;
-                mask = shift(mask, dir);
-            }
+        if (!move || ((player | opponent) & move)) return false;
 
-            if ((mask & player) && flipped) {
+        const int sq = __builtin_ctzll(move);
+        for (int dir = 0; dir < 8; ++dir) {
+            if (ray_flips(sq, dir, player, opponent)) {
                 return true;
             }
         }
@@ -108,19 +167,11 @@ struct Board {
         uint64_t player = is_black ? black : white;
         uint64_t opponent = is_black ? white : black;
         uint64_t to_flip = 0;
+        if (!move) return; // pass
 
+        const int sq = __builtin_ctzll(move);
         for (int dir = 0; dir < 8; ++dir) {
-            uint64_t temp_flip = 0;
-            uint64_t cursor = shift(move, dir);
-            
-            while (cursor && (cursor & opponent)) {
-                temp_flip |= cursor;
-                cursor = shift(cursor, dir);
-            }
-            
-            if (cursor & player) {
-                to_flip |= temp_flip;
-            }
+            to_flip |= ray_flips(sq, dir, player, opponent);
         }
 
         player ^= move | to_flip;
@@ -136,7 +187,27 @@ struct Board {
     }
 
     bool is_game_over() const {
-        return get_moves(true).empty() && get_moves(false).empty();
+        return !get_move_mask(true) && !get_move_mask(false);
     }
 
 };
+
+
+// bitboard to notation
+inline std::string move_to_notation(uint64_t move) {
+    if (move == 0) return "pass";
+
+    int pos = __builtin_ctzll(move);
+    int row = pos / 8 + 1;
+    char col = 'a' + (pos % 8);
+    return std::string(1, col) + std::to_string(row);
+}
+
+// notation to bitboard
+inline uint64_t notation_to_move(const std::string& notation) {
+    if (notation == "pass") return 0;
+
+    int row = notation[1] - '0';
+    int col = notation[0] - 'a';
+    return 1ULL << ((row - 1) * 8 + col);
+}
@@ -0,0 +1,73 @@
+// Converts between text transcripts (one game per line, "f5 d6 c3 ...")
+// and the binary games format in gameFormat.hpp
+#include "gameFormat.hpp"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using std::cerr;
+using std::cout;
+
+int to_binary(const std::string& input, const std::string& output) {
+    std::ifstream in(input);
+    if (!in) {
+        cerr << "Cannot open " << input << "\n";
+        return 1;
+    }
+    GameFormat::GameWriter writer(output);
+    if (!writer.is_open()) {
+        cerr << "Cannot create " << output << "\n";
+        return 1;
+    }
+
+    std::string line;
+    std::vector<uint8_t> squares;
+    size_t line_number = 0, skipped = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        if (!GameFormat::from_transcript(line, squares)) {
+            cerr << input << ":" << line_number << ": invalid game, skipped\n";
+            ++skipped;
+            continue;
+        }
+        writer.write(GameFormat::view(squares));
+    }
+
+    const uint64_t games = writer.size();
+    if (!writer.close()) {
+        cerr << "Write to " << output << " failed\n";
+        return 1;
+    }
+    cout << games << " games written, " << skipped << " skipped\n";
+    return 0;
+}
+
+int to_text(const std::string& input, const std::string& output) {
+    GameFormat::GameReader reader(input);
+    if (!reader.is_open()) {
+        cerr << "Not a valid games file: " << input << "\n";
+        return 1;
+    }
+    std::ofstream out(output);
+    if (!out) {
+        cerr << "Cannot create " << output << "\n";
+        return 1;
+    }
+
+    reader.for_each([&out](GameFormat::GameView game) {
+        out << GameFormat::to_transcript(game) << "\n";
+    });
+    cout << reader.size() << " games written\n";
+    return out.good() ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    const std::string mode = argc == 4 ? argv[1] : "";
+    if (mode == "to-binary") return to_binary(argv[2], argv[3]);
+    if (mode == "to-text") return to_text(argv[2], argv[3]);
+
+    cerr << "Usage: " << argv[0] << " to-binary <games.txt> <games.ogm>\n"
+         << "       " << argv[0] << " to-text <games.ogm> <games.txt>\n";
+    return 2;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "board.hpp"
+#include "mappedFile.hpp"
+#include "zobrist.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+struct EndgameEntry {
+    uint64_t key;          // Zobrist::canonical_hash
+    uint32_t stamp;        // last access, for LRU eviction
+    int8_t score;          // exact final disc difference for the side to move
+    uint8_t best_square;   // in canonical orientation, NO_SQUARE for a pass
+    uint8_t empties;       // 0 marks an unused slot
+    uint8_t padding;
+};
+static_assert(sizeof(EndgameEntry) == 16, "EndgameEntry must stay 16 bytes (file format)");
+
+
+// Solved endgame positions, shared across searches and saved between runs.
+// Positions are keyed by side-to-move/opponent discs over all 8 symmetries,
+// so mirrored and color-swapped positions share one entry.
+class EndgameCache {
+    static constexpr size_t BUCKET_SIZE = 4;
+    static constexpr uint8_t NO_SQUARE = 0xFF;
+    static constexpr uint32_t FILE_MAGIC = 0x4345544F; // "OTEC"
+    static constexpr uint32_t FILE_VERSION = 2; // bump when Zobrist keys change
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t count;
+    };
+
+    std::vector<EndgameEntry> table;
+    size_t bucket_mask;
+    uint32_t clock = 0;
+
+public:
+    static constexpr int MIN_EMPTIES = 12;            // shallower solves are cheaper than a lookup
+    static constexpr size_t DEFAULT_BUDGET = 64 << 20; // 64 MB
+
+    explicit EndgameCache(size_t budget_bytes = DEFAULT_BUDGET) {
+        size_t buckets = 1;
+        while (buckets * 2 * BUCKET_SIZE * sizeof(EndgameEntry) <= budget_bytes) buckets *= 2;
+        table.resize(buckets * BUCKET_SIZE);
+        bucket_mask = buckets - 1;
+    }
+
+    bool probe(uint64_t player, uint64_t opponent, int& score, uint64_t& best_move) {
+        int sym = 0;
+        uint64_t key = Zobrist::canonical_hash(player, opponent, sym);
+        EndgameEntry* bucket = &table[(key & bucket_mask) * BUCKET_SIZE];
+
+        for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+            EndgameEntry& entry = bucket[i];
+            if (entry.empties && entry.key == key) {
+                entry.stamp = ++clock;
+                score = entry.score;
+                best_move = from_canonical(entry.best_square, sym);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void store(uint64_t player, uint64_t opponent, int score, uint64_t best_move) {
+        int sym = 0;
+        EndgameEntry entry{};
+        entry.key = Zobrist::canonical_hash(player, opponent, sym);
+        entry.score = static_cast<int8_t>(score);
+        entry.best_square = best_move ? __builtin_ctzll(Board::transform(best_move, sym)) : NO_SQUARE;
+        entry.empties = 64 - __builtin_popcountll(player | opponent);
+        entry.stamp = ++clock;
+        insert(entry);
+    }
+
+    size_t size() const {
+        size_t used = 0;
+        for (const auto& entry : table) used += entry.empties != 0;
+        return used;
+    }
+
+    // Merge a saved cache into the table. The file is mapped read-only and
+    // read once: every entry is copied into the in-memory table at startup,
+    // probes never touch the mapping.
+    bool load(const std::string& path) {
+        MappedFile file(path);
+        if (!file.is_open() || file.size() < sizeof(FileHeader)) return false;
+
+        const auto* header = reinterpret_cast<const FileHeader*>(file.data());
+        if (header->magic != FILE_MAGIC || header->version != FILE_VERSION ||
+            header->count > (file.size() - sizeof(FileHeader)) / sizeof(EndgameEntry)) {
+            return false;
+        }
+
+        const auto* entries = reinterpret_cast<const EndgameEntry*>(file.data() + sizeof(FileHeader));
+        for (uint64_t i = 0; i < header->count; ++i) {
+            if (!is_valid(entries[i])) continue;
+            clock = std::max(clock, entries[i].stamp);
+            insert(entries[i]);
+        }
+        return true;
+    }
+
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        FileHeader header{FILE_MAGIC, FILE_VERSION, size()};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& entry : table) {
+            if (entry.empties) out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        }
+        return static_cast<bool>(out);
+    }
+
+private:
+    // The file comes from the working directory: skip anything store() can't produce
+    static bool is_valid(const EndgameEntry& entry) {
+        return entry.empties != 0 && entry.empties <= 60 && entry.score >= -64 && entry.score <= 64 &&
+               (entry.best_square < 64 || entry.best_square == NO_SQUARE);
+    }
+
+    // Replace the same key, else a free slot, else the entry with the fewest
+    // empties (cheapest to re-solve), least recently used first.
+    void insert(const EndgameEntry& entry) {
+        EndgameEntry* bucket = &table[(entry.key & bucket_mask) * BUCKET_SIZE];
+        EndgameEntry* victim = &bucket[0];
+
+        for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+            EndgameEntry& slot = bucket[i];
+            if (slot.empties == 0 || slot.key == entry.key) {
+                victim = &slot;
+                break;
+            }
+            if (slot.empties < victim->empties ||
+                (slot.empties == victim->empties && slot.stamp < victim->stamp)) {
+                victim = &slot;
+            }
+        }
+        *victim = entry;
+    }
+
+    static uint64_t from_canonical(uint8_t square, int sym) {
+        if (square == NO_SQUARE) return 0;
+        return Board::inverse_transform(1ULL << square, sym);
+    }
+};
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "board.hpp"
+#include "openingBook.hpp"
+#include "search.hpp"
+#include "transPositionTable.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+struct EngineHostConfig {
+    unsigned threads = 0;           // search workers, 0 = one per hardware thread
+    size_t max_sessions = 32;       // one pooled table per session slot
+    size_t tt_mb_per_session = 16;
+    size_t queue_capacity = 128;    // pending requests before new ones are rejected
+    int deadline_margin_ms = 2;     // kept free for handing the reply back
+    int max_depth = 60;
+};
+
+enum RequestStatus : uint8_t {
+    REQUEST_OK,
+    REQUEST_BOOK,       // answered from the opening book without a search
+    REQUEST_REJECTED,   // unknown or busy session, full queue, or shutting down
+    REQUEST_EXPIRED     // the deadline passed before a worker got to it
+};
+
+struct MoveReply {
+    RequestStatus status = REQUEST_REJECTED;
+    SearchResult result;
+    int queue_ms = 0;   // time spent waiting for a worker
+};
+
+
+// Hosts many concurrent games in one process. A fixed pool of workers serves
+// move requests from all sessions. Sessions take their transposition table
+// from a pool allocated up front, so memory is bounded by max_sessions. The
+// opening book and the (compile-time) evaluation tables are shared read-only.
+class EngineHost {
+    // Session ids carry the slot in the low bits and the slot's generation
+    // above, so an id kept after close_session() can't reach the slot's next owner
+    static constexpr int SLOT_BITS = 16;
+    static constexpr int GENERATION_MASK = 0x7FFF; // keeps ids positive
+
+    struct Session {
+        bool open = false;
+        bool busy = false;      // a request is queued or running, or the table is being cleared
+        int generation = 0;
+    };
+
+    struct Job {
+        int slot;
+        Board board;
+        bool is_black;
+        int time_ms;
+        steady_clock::time_point submitted;
+        steady_clock::time_point deadline;
+        std::promise<MoveReply> reply;
+    };
+
+    EngineHostConfig config;
+    const OpeningBook* book;
+    std::vector<std::unique_ptr<TranspositionTable>> tables; // tables[i] belongs to session i
+    std::vector<Session> sessions;
+
+    std::mutex lock;
+    std::condition_variable work_ready;
+    std::deque<Job> queue;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+public:
+    explicit EngineHost(const EngineHostConfig& cfg = EngineHostConfig{}, const OpeningBook* opening_book = nullptr)
+        : config(cfg), book(opening_book) {
+        config.max_sessions = std::min<size_t>(config.max_sessions, 1 << SLOT_BITS); // the slot must fit in an id
+        sessions.resize(config.max_sessions);
+        TTConfig tt_config;
+        tt_config.size_mb = config.tt_mb_per_session;
+        tt_config.clear_threads = 1; // workers are already busy with searches
+        for (size_t i = 0; i < config.max_sessions; ++i) {
+            tables.push_back(std::make_unique<TranspositionTable>(tt_config));
+        }
+
+        if (config.threads == 0) config.threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 0; t < config.threads; ++t) workers.emplace_back(&EngineHost::worker, this);
+    }
+
+    ~EngineHost() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        work_ready.notify_all();
+        for (auto& thread : workers) thread.join();
+    }
+
+    EngineHost(const EngineHost&) = delete;
+    EngineHost& operator=(const EngineHost&) = delete;
+
+    // Returns a session id, or -1 when every pooled table is taken
+    int open_session() {
+        int slot = -1, id = -1;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (size_t i = 0; i < sessions.size(); ++i) {
+                Session& session = sessions[i];
+                if (!session.open && !session.busy) {
+                    session.open = true;
+                    session.busy = true; // until the table is clear
+                    session.generation = (session.generation + 1) & GENERATION_MASK;
+                    slot = static_cast<int>(i);
+                    id = session.generation << SLOT_BITS | slot;
+                    break;
+                }
+            }
+        }
+        if (slot < 0) return -1;
+
+        tables[slot]->clear(); // no stale entries from the previous owner
+        std::lock_guard<std::mutex> guard(lock);
+        sessions[slot].busy = false;
+        return id;
+    }
+
+    // A request still in flight finishes; the slot is reused after that
+    void close_session(int id) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (valid_session(id)) sessions[slot_of(id)].open = false;
+    }
+
+    // Queue a search for the position. The search is cut short to meet the
+    // deadline; requests that can't meet it, or arrive when the session is
+    // busy or the queue is full, are answered immediately.
+    std::future<MoveReply> request_move(int session, const Board& board, bool is_black, int time_ms,
+                                        steady_clock::time_point deadline) {
+        std::promise<MoveReply> reply;
+        std::future<MoveReply> future = reply.get_future();
+
+        const uint64_t book_move = book ? book->probe(board, is_black) : 0;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            const bool admitted = !stopping && valid_session(session) && !sessions[slot_of(session)].busy &&
+                                  queue.size() < config.queue_capacity;
+            if (admitted && !book_move) {
+                const int slot = slot_of(session);
+                sessions[slot].busy = true;
+                queue.push_back({slot, board, is_black, time_ms, steady_clock::now(), deadline, std::move(reply)});
+                work_ready.notify_one();
+                return future;
+            }
+            if (admitted) {
+                MoveReply answer;
+                answer.status = REQUEST_BOOK;
+                answer.result.move = book_move;
+                reply.set_value(answer);
+                return future;
+            }
+        }
+
+        reply.set_value(MoveReply{});
+        return future;
+    }
+
+    size_t pending() {
+        std::lock_guard<std::mutex> guard(lock);
+        return queue.size();
+    }
+
+private:
+    static int slot_of(int id) { return id & ((1 << SLOT_BITS) - 1); }
+
+    // An open session whose generation matches the id; call with the lock held
+    bool valid_session(int id) const {
+        if (id < 0 || static_cast<size_t>(slot_of(id)) >= sessions.size()) return false;
+        const Session& session = sessions[slot_of(id)];
+        return session.open && session.generation == id >> SLOT_BITS;
+    }
+
+    void worker() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                work_ready.wait(guard, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) return; // stopping and drained
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            MoveReply answer;
+            const auto now = steady_clock::now();
+            answer.queue_ms = static_cast<int>(duration_cast<milliseconds>(now - job.submitted).count());
+            const auto remaining = duration_cast<milliseconds>(job.deadline - now).count() - config.deadline_margin_ms;
+
+            if (stopping) {
+                answer.status = REQUEST_REJECTED;
+            } else if (remaining <= 0) {
+                answer.status = REQUEST_EXPIRED;
+            } else {
+                const int budget = static_cast<int>(std::min<long long>(job.time_ms, remaining));
+                Search searcher(nullptr, tables[job.slot].get());
+                answer.result = searcher.iterative_deepening(job.board, job.is_black, budget, config.max_depth);
+                answer.status = REQUEST_OK;
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                sessions[job.slot].busy = false;
+            }
+            job.reply.set_value(answer);
+        }
+    }
+};
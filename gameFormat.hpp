@@ -0,0 +1,369 @@
+#pragma once
+
+#include "board.hpp"
+#include "mappedFile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compact binary files for games and positions (little-endian).
+//
+// Games file:     FileHeader, then blocks of BlockHeader + up to GAMES_PER_BLOCK
+//                 games. A game is one length byte followed by one square
+//                 index (0-63) per move. Passes are implicit: a side without a
+//                 legal move passes, so every game replays from the start position.
+// Positions file: FileHeader, then fixed-size PositionRecords.
+//
+// Readers memory-map the file. Blocks (games) and record ranges (positions)
+// can be decoded in parallel.
+namespace GameFormat {
+    constexpr uint32_t GAMES_MAGIC = 0x4D47544F;     // "OTGM"
+    constexpr uint32_t POSITIONS_MAGIC = 0x5350544F; // "OTPS"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t GAMES_PER_BLOCK = 4096;
+    constexpr size_t MAX_GAME_MOVES = 60;
+    constexpr uint8_t NO_SQUARE = 0xFF;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t count; // games or positions
+    };
+
+    struct BlockHeader {
+        uint32_t games;
+        uint32_t bytes; // payload size after this header
+    };
+
+    struct PositionRecord {
+        uint64_t black;
+        uint64_t white;
+        int32_t score;         // black's point of view
+        uint8_t black_to_move;
+        uint8_t best_square;   // NO_SQUARE if unknown
+        uint8_t depth;
+        uint8_t padding;
+    };
+    static_assert(sizeof(PositionRecord) == 24, "PositionRecord is part of the file format");
+
+    // Moves of one game as square indices, pointing into a buffer or a mapped file
+    struct GameView {
+        const uint8_t* squares;
+        size_t length;
+    };
+
+    inline GameView view(const std::vector<uint8_t>& squares) {
+        return {squares.data(), squares.size()};
+    }
+
+    // Replay a game from the start position through Board::make_move.
+    // visit(board, is_black, move) runs before every move. Returns false on an
+    // illegal move; board then holds the last legal position.
+    template<typename Visit>
+    bool replay(GameView game, Board& board, Visit&& visit) {
+        board = Board();
+        bool is_black = true;
+        for (size_t i = 0; i < game.length; ++i) {
+            if (!board.get_move_mask(is_black)) is_black = !is_black; // forced pass
+
+            const uint8_t square = game.squares[i];
+            if (square >= 64) return false;
+            const uint64_t move = 1ULL << square;
+            if (!board.is_valid_move(move, is_black)) return false;
+
+            visit(static_cast<const Board&>(board), is_black, move);
+            board.make_move(move, is_black);
+            is_black = !is_black;
+        }
+        return true;
+    }
+
+    inline bool replay(GameView game, Board& board) {
+        return replay(game, board, [](const Board&, bool, uint64_t) {});
+    }
+
+    // Text transcripts: one game per line, moves as "f5 d6 c3 ..." (spaces optional)
+    inline std::string to_transcript(GameView game) {
+        std::string text;
+        for (size_t i = 0; i < game.length; ++i) {
+            if (i) text += ' ';
+            text += move_to_notation(1ULL << game.squares[i]);
+        }
+        return text;
+    }
+
+    inline bool is_pass(const std::string& line, size_t i) {
+        static const char PASS[] = "pass";
+        if (line.size() - i < 4) return false;
+        for (size_t k = 0; k < 4; ++k) {
+            if (std::tolower(static_cast<unsigned char>(line[i + k])) != PASS[k]) return false;
+        }
+        return true;
+    }
+
+    // Parses and validates a transcript line, in any case; "pass" tokens are
+    // accepted and ignored
+    inline bool from_transcript(const std::string& line, std::vector<uint8_t>& squares) {
+        squares.clear();
+        size_t i = 0;
+        while (i < line.size()) {
+            const char c = std::tolower(static_cast<unsigned char>(line[i]));
+            if (std::isspace(static_cast<unsigned char>(c)) || c == ',') {
+                ++i;
+            } else if (is_pass(line, i)) {
+                i += 4;
+            } else if (c >= 'a' && c <= 'h' && i + 1 < line.size() && line[i + 1] >= '1' && line[i + 1] <= '8') {
+                squares.push_back((line[i + 1] - '1') * 8 + (c - 'a'));
+                i += 2;
+            } else {
+                return false;
+            }
+        }
+        Board board;
+        return squares.size() <= MAX_GAME_MOVES && replay(view(squares), board);
+    }
+
+
+    class GameWriter {
+        std::ofstream out;
+        std::vector<uint8_t> block;
+        uint32_t block_games = 0;
+        uint64_t count = 0;
+
+    public:
+        explicit GameWriter(const std::string& path) : out(path, std::ios::binary | std::ios::trunc) {
+            write_header();
+        }
+
+        ~GameWriter() { close(); }
+
+        bool is_open() const { return out.is_open() && out.good(); }
+        uint64_t size() const { return count; }
+
+        bool write(GameView game) {
+            if (!out.is_open() || game.length > MAX_GAME_MOVES) return false;
+            // GameReader rejects the whole file over one bad square
+            if (std::any_of(game.squares, game.squares + game.length, [](uint8_t sq) { return sq >= 64; })) return false;
+            block.push_back(static_cast<uint8_t>(game.length));
+            block.insert(block.end(), game.squares, game.squares + game.length);
+            ++count;
+            if (++block_games == GAMES_PER_BLOCK) flush_block();
+            return true;
+        }
+
+        // Flushes the last block and patches the game count into the header
+        bool close() {
+            if (!out.is_open()) return false;
+            flush_block();
+            out.seekp(0);
+            write_header();
+            const bool ok = out.good();
+            out.close();
+            return ok;
+        }
+
+    private:
+        void write_header() {
+            FileHeader header{GAMES_MAGIC, VERSION, count};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        void flush_block() {
+            if (block_games == 0) return;
+            BlockHeader header{block_games, static_cast<uint32_t>(block.size())};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(block.data()), block.size());
+            block.clear();
+            block_games = 0;
+        }
+    };
+
+
+    class GameReader {
+        MappedFile file;
+        std::vector<size_t> blocks; // offsets of the block headers
+        uint64_t count = 0;
+        bool valid = false;
+
+    public:
+        // Maps the file and checks the block structure up front, so decoding
+        // (sequential or parallel) never reads out of bounds
+        explicit GameReader(const std::string& path) : file(path) {
+            if (!file.is_open() || file.size() < sizeof(FileHeader)) return;
+            const auto* header = reinterpret_cast<const FileHeader*>(file.data());
+            if (header->magic != GAMES_MAGIC || header->version != VERSION) return;
+
+            uint64_t games = 0;
+            size_t offset = sizeof(FileHeader);
+            while (offset < file.size()) {
+                if (file.size() - offset < sizeof(BlockHeader)) return;
+                const BlockHeader block = block_header(offset);
+                const size_t payload = offset + sizeof(BlockHeader);
+                if (file.size() - payload < block.bytes || !check_block(payload, block)) return;
+
+                blocks.push_back(offset);
+                games += block.games;
+                offset = payload + block.bytes;
+            }
+            count = header->count;
+            valid = games == count;
+        }
+
+        bool is_open() const { return valid; }
+        uint64_t size() const { return count; }
+        size_t block_count() const { return blocks.size(); }
+
+        // visit(GameView) for every game, in file order
+        template<typename Visit>
+        void for_each(Visit&& visit) const {
+            for (size_t i = 0; i < blocks.size(); ++i) decode_block(i, visit);
+        }
+
+        // visit(GameView) from several threads, one block at a time per thread.
+        // visit must be thread-safe; order across blocks is unspecified.
+        template<typename Visit>
+        void for_each_parallel(Visit&& visit, unsigned threads = std::thread::hardware_concurrency()) const {
+            threads = std::max(1u, std::min<unsigned>(threads, blocks.size()));
+            std::atomic<size_t> next{0};
+            auto worker = [&]() {
+                for (size_t i = next++; i < blocks.size(); i = next++) decode_block(i, visit);
+            };
+
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+            worker();
+            for (auto& thread : pool) thread.join();
+        }
+
+    private:
+        // Blocks follow variable-length payloads, so headers are unaligned
+        BlockHeader block_header(size_t offset) const {
+            BlockHeader header;
+            memcpy(&header, file.data() + offset, sizeof(header));
+            return header;
+        }
+
+        // Lengths must tile the payload and every square must be on the
+        // board, so a file that passes is safe to decode
+        bool check_block(size_t payload, const BlockHeader& block) const {
+            const uint8_t* data = file.data() + payload;
+            size_t offset = 0;
+            for (uint32_t g = 0; g < block.games; ++g) {
+                if (offset >= block.bytes) return false;
+                const uint8_t length = data[offset];
+                if (length > MAX_GAME_MOVES || block.bytes - offset - 1 < length) return false;
+                for (size_t i = 1; i <= length; ++i) {
+                    if (data[offset + i] >= 64) return false;
+                }
+                offset += 1 + length;
+            }
+            return offset == block.bytes;
+        }
+
+        template<typename Visit>
+        void decode_block(size_t index, Visit& visit) const {
+            const BlockHeader block = block_header(blocks[index]);
+            const uint8_t* cursor = file.data() + blocks[index] + sizeof(BlockHeader);
+            for (uint32_t g = 0; g < block.games; ++g) {
+                const uint8_t length = *cursor++;
+                visit(GameView{cursor, length});
+                cursor += length;
+            }
+        }
+    };
+
+
+    class PositionWriter {
+        std::ofstream out;
+        uint64_t count = 0;
+
+    public:
+        explicit PositionWriter(const std::string& path) : out(path, std::ios::binary | std::ios::trunc) {
+            write_header();
+        }
+
+        ~PositionWriter() { close(); }
+
+        bool is_open() const { return out.is_open() && out.good(); }
+        uint64_t size() const { return count; }
+
+        bool write(const PositionRecord& record) {
+            if (!out.is_open()) return false;
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            ++count;
+            return true;
+        }
+
+        bool write(const Board& board, bool black_to_move, int score = 0, uint64_t best_move = 0, int depth = 0) {
+            PositionRecord record{};
+            record.black = board.black;
+            record.white = board.white;
+            record.score = score;
+            record.black_to_move = black_to_move;
+            record.best_square = best_move ? __builtin_ctzll(best_move) : NO_SQUARE;
+            record.depth = static_cast<uint8_t>(depth);
+            return write(record);
+        }
+
+        bool close() {
+            if (!out.is_open()) return false;
+            out.seekp(0);
+            write_header();
+            const bool ok = out.good();
+            out.close();
+            return ok;
+        }
+
+    private:
+        void write_header() {
+            FileHeader header{POSITIONS_MAGIC, VERSION, count};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+    };
+
+
+    class PositionReader {
+        MappedFile file;
+        const PositionRecord* records = nullptr;
+        uint64_t count = 0;
+
+    public:
+        explicit PositionReader(const std::string& path) : file(path) {
+            if (!file.is_open() || file.size() < sizeof(FileHeader)) return;
+            const auto* header = reinterpret_cast<const FileHeader*>(file.data());
+            if (header->magic != POSITIONS_MAGIC || header->version != VERSION) return;
+            if (header->count != (file.size() - sizeof(FileHeader)) / sizeof(PositionRecord)) return;
+
+            records = reinterpret_cast<const PositionRecord*>(file.data() + sizeof(FileHeader));
+            count = header->count;
+        }
+
+        bool is_open() const { return records != nullptr; }
+        uint64_t size() const { return count; }
+        const PositionRecord* begin() const { return records; }
+        const PositionRecord* end() const { return records + count; }
+        const PositionRecord& operator[](size_t i) const { return records[i]; }
+
+        // visit(const PositionRecord&) over contiguous chunks, one per thread
+        template<typename Visit>
+        void for_each_parallel(Visit&& visit, unsigned threads = std::thread::hardware_concurrency()) const {
+            threads = std::max<uint64_t>(1, std::min<uint64_t>(threads, count));
+            const uint64_t chunk = (count + threads - 1) / threads;
+            auto worker = [&](uint64_t first) {
+                const uint64_t last = std::min(count, first + chunk);
+                for (uint64_t i = first; i < last; ++i) visit(records[i]);
+            };
+
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t * chunk);
+            worker(0);
+            for (auto& thread : pool) thread.join();
+        }
+    };
+}
@@ -1,6 +1,8 @@
 // gui.cpp
 #include "board.hpp"
+#include "endgameCache.hpp"
 #include "search.hpp"
+#include "spscQueue.hpp"
 #include <raylib.h>
 #include <future>
 #include <thread>
@@ -13,6 +15,7 @@ const int CELL_SIZE = SCREEN_HEIGHT / 8;
 const int BOARD_OFFSET_X = (SCREEN_WIDTH - SCREEN_HEIGHT) / 2;
 const int TIME_LIMIT_MS = 5000; 
 const int MAX_DEPTH = 60;
+const char* ENDGAME_CACHE_FILE = "endgame.cache";
 
 // Colors
 const Color DARK_GREEN = {34, 139, 34, 255};
@@ -20,17 +23,36 @@ const Color LIGHT_GREEN = {144, 238, 144, 255};
 const Color BLACK_PIECE = {25, 25, 25, 255};
 const Color WHITE_PIECE = {230, 230, 230, 255};
 const Color LEGAL_MOVE_COLOR = {255, 255, 0, 100};
+const Color PANEL_COLOR = {255, 255, 255, 190};
+
+const Rectangle MOVE_NOW_BUTTON = {SCREEN_WIDTH - 130, 10, 120, 30};
 
 struct GameState {
     Board board;
     bool human_is_black;
     bool current_player_black = true;
-    std::vector<uint64_t> current_moves;
+    std::vector<uint64_t> current_moves; // cached, see UpdatePosition
+    bool game_over = false;
     std::atomic<bool> ai_thinking{false};
+    std::atomic<bool> stop_search{false};
     std::future<SearchResult> ai_result;
+    SpscQueue<SearchInfo, 64> search_info; // search thread -> render loop
+    SearchInfo last_info;
     uint64_t last_ai_move = 0;
+    EndgameCache endgame_cache;
 };
 
+// Refresh the cached legal moves and game-over flag, passing if needed.
+// Only called when the position changes, not every frame.
+void UpdatePosition(GameState& state) {
+    state.game_over = state.board.is_game_over();
+    state.current_moves = state.board.get_moves(state.current_player_black);
+    if (state.current_moves.empty() && !state.game_over) {
+        state.current_player_black = !state.current_player_black;
+        state.current_moves = state.board.get_moves(state.current_player_black);
+    }
+}
+
 void DrawBoard(const GameState& state) {
     // Draw board background
     for (int row = 0; row < 8; row++) {
@@ -76,9 +98,38 @@ void DrawBoard(const GameState& state) {
     }
 }
 
+void DrawSearchInfo(const GameState& state) {
+    DrawRectangle(0, 0, SCREEN_WIDTH, 80, PANEL_COLOR);
+    DrawText("AI is thinking...", 10, 10, 20, DARKGRAY);
+
+    // Move-now button
+    DrawRectangleRec(MOVE_NOW_BUTTON, LIGHTGRAY);
+    DrawRectangleLines(MOVE_NOW_BUTTON.x, MOVE_NOW_BUTTON.y, MOVE_NOW_BUTTON.width, MOVE_NOW_BUTTON.height, DARKGRAY);
+    DrawText(state.stop_search ? "Stopping..." : "Move now", MOVE_NOW_BUTTON.x + 12, MOVE_NOW_BUTTON.y + 7, 18, BLACK);
+
+    const SearchInfo& info = state.last_info;
+    if (info.depth == 0) return;
+
+    // Exact endgame values are INF/2 + disc difference; show them as the result
+    std::string score;
+    if (info.value > INF / 2) score = TextFormat("black wins by %d", info.value - INF / 2);
+    else if (info.value < -INF / 2) score = TextFormat("white wins by %d", -INF / 2 - info.value);
+    else score = TextFormat("score %d", info.value);
+
+    DrawText(TextFormat("depth %d   %s   %llu knps", info.depth, score.c_str(),
+                        static_cast<unsigned long long>(info.nps / 1000)), 10, 35, 18, DARKGRAY);
+
+    std::string pv = "pv:";
+    for (int i = 0; i < info.pv_length; ++i) {
+        pv += " " + move_to_notation(1ULL << info.pv[i]);
+    }
+    DrawText(pv.c_str(), 10, 57, 18, DARKGRAY);
+}
+
 void RunGUI(GameState& state) {
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Othello");
     SetTargetFPS(60);
+    UpdatePosition(state);
 
     while (!WindowShouldClose()) {
         // Human move handling
@@ -94,21 +145,42 @@ void RunGUI(GameState& state) {
                         state.board.make_move(move, state.current_player_black);
                         state.current_player_black = !state.current_player_black;
                         state.last_ai_move = 0;
+                        UpdatePosition(state);
                     }
                 }
             }
         }
 
         // AI move handling
-        if (!state.ai_thinking && state.current_player_black != state.human_is_black) {
+        if (!state.ai_thinking && !state.game_over && state.current_player_black != state.human_is_black) {
             state.ai_thinking = true;
-            state.ai_result = std::async(std::launch::async, [&state]() {
-                Board ai_board = state.board;
-                Search searcher;
-                return searcher.iterative_deepening(ai_board, state.current_player_black, TIME_LIMIT_MS, MAX_DEPTH);
+            state.stop_search = false;
+            SearchInfo stale; // the previous search's last report, if the human passed
+            while (state.search_info.pop(stale)) {}
+            state.last_info = SearchInfo{};
+            Board ai_board = state.board;
+            bool ai_is_black = state.current_player_black;
+            state.ai_result = std::async(std::launch::async, [&state, ai_board, ai_is_black]() mutable {
+                Search searcher(&state.endgame_cache);
+                searcher.set_stop_flag(&state.stop_search);
+                searcher.set_info_callback([&state](const SearchInfo& info) {
+                    state.search_info.push(info); // dropped if the GUI falls behind
+                });
+                return searcher.iterative_deepening(ai_board, ai_is_black, TIME_LIMIT_MS, MAX_DEPTH);
             });
         }
 
+        // Drain search progress
+        SearchInfo info;
+        while (state.search_info.pop(info)) {
+            state.last_info = info;
+        }
+
+        if (state.ai_thinking && IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+            CheckCollisionPointRec(GetMousePosition(), MOVE_NOW_BUTTON)) {
+            state.stop_search = true;
+        }
+
         // Check AI result
         if (state.ai_thinking && state.ai_result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
             SearchResult result = state.ai_result.get();
@@ -116,12 +188,7 @@ void RunGUI(GameState& state) {
             state.last_ai_move = result.move;
             state.current_player_black = !state.current_player_black;
             state.ai_thinking = false;
-        }
-
-        // Update legal moves
-        state.current_moves = state.board.get_moves(state.current_player_black);
-        if (state.current_moves.empty() && !state.board.is_game_over()) {
-            state.current_player_black = !state.current_player_black;
+            UpdatePosition(state);
         }
 
         // Drawing
@@ -130,10 +197,10 @@ void RunGUI(GameState& state) {
         DrawBoard(state);
         
         if (state.ai_thinking) {
-            DrawText("AI is thinking...", 10, 10, 20, DARKGRAY);
+            DrawSearchInfo(state);
         }
         
-        if (state.board.is_game_over()) {
+        if (state.game_over) {
             int black = __builtin_popcountll(state.board.black);
             int white = __builtin_popcountll(state.board.white);
             const char* text = black > white ? "Black wins!" : white > black ? "White wins!" : "Draw!";
@@ -174,6 +241,10 @@ int main() {
     }
     CloseWindow();
 
+    state.endgame_cache.load(ENDGAME_CACHE_FILE);
     RunGUI(state);
+    state.stop_search = true;
+    if (state.ai_result.valid()) state.ai_result.wait();
+    state.endgame_cache.save(ENDGAME_CACHE_FILE);
     return 0;
 }
\ No newline at end of file
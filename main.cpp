@@ -1,4 +1,5 @@
 #include "board.hpp"
+#include "endgameCache.hpp"
 #include "search.hpp"
 #include <iostream>
 #include <utility>
@@ -17,16 +18,6 @@ std::pair<int, int> convert_move(uint64_t move) {
     return {row, col};
 }
 
-// bitboard to notation
-std::string move_to_notation(uint64_t move) {
-    if (move == 0) return "pass";
-    
-    int pos = __builtin_ctzll(move);
-    int row = pos / 8 + 1;
-    char col = 'a' + (pos % 8);
-    return std::string(1, col) + std::to_string(row);
-}
-
 void print_moves(const vector<uint64_t>& moves) {
     for (uint64_t move : moves) {
         int pos = __builtin_ctzll(move); // Get the index of the first set bit
@@ -45,15 +36,6 @@ void print_moves_notation(const vector<uint64_t>& moves) {
     cout << endl;
 }
 
-// notation to bitboard
-uint64_t notation_to_move(const std::string& notation) {
-    if (notation == "pass") return 0;
-
-    int row = notation[1] - '0';
-    int col = notation[0] - 'a';
-    return 1ULL << ((row - 1) * 8 + col);
-}
-
 
 int main() {
     Board board;
@@ -67,6 +49,10 @@ int main() {
     bool current_player_is_black = true; // Black always starts
     const int TIME_LIMIT_MS = 5000; 
     const int MAX_DEPTH = 60;
+    const char* ENDGAME_CACHE_FILE = "endgame.cache";
+
+    EndgameCache endgame_cache;
+    endgame_cache.load(ENDGAME_CACHE_FILE);
 
 
     while (!board.is_game_over()) {
@@ -105,7 +91,7 @@ int main() {
             }
         } else {
             cout << "AI is processing...\n";
-            Search searcher;
+            Search searcher(&endgame_cache);
             SearchResult result = searcher.iterative_deepening(
                 board, current_player_is_black, TIME_LIMIT_MS, MAX_DEPTH
             );
@@ -121,6 +107,8 @@ int main() {
         current_player_is_black = !current_player_is_black;
     }
 
+    endgame_cache.save(ENDGAME_CACHE_FILE);
+
     board.print();
     int black_count = __builtin_popcountll(board.black);
     int white_count = __builtin_popcountll(board.white);
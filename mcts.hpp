@@ -0,0 +1,310 @@
+#pragma once
+
+#include "board.hpp"
+#include "evaluation.hpp"
+#include "search.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+struct MCTSConfig {
+    unsigned threads = 0;          // 0 = one per hardware thread
+    size_t max_nodes = 1 << 21;    // arena capacity (32 bytes per node)
+    double exploration = 1.0;      // UCT constant
+    int virtual_loss = 3;          // visits added while a thread is below a node
+    int playouts_per_leaf = 4;     // playouts run as one batch per selected leaf
+    bool guided_playouts = true;   // corners first, X-squares last
+};
+
+
+enum NodeState : uint8_t { UNEXPANDED, EXPANDING, EXPANDED };
+
+struct MCTSNode {
+    uint64_t move;                        // move leading here, 0 for a pass
+    uint32_t first_child;                 // valid once state is EXPANDED
+    uint16_t child_count;                 // 0 when EXPANDED means game over
+    std::atomic<uint8_t> state;
+    std::atomic<int32_t> visits;
+    std::atomic<int32_t> virtual_visits;
+    std::atomic<int64_t> score;           // 2 per win, 1 per draw, for the side that played move
+
+    void init(uint64_t m) {
+        move = m;
+        first_child = 0;
+        child_count = 0;
+        state.store(UNEXPANDED, std::memory_order_relaxed);
+        visits.store(0, std::memory_order_relaxed);
+        virtual_visits.store(0, std::memory_order_relaxed);
+        score.store(0, std::memory_order_relaxed);
+    }
+};
+
+
+// Monte Carlo Tree Search (UCT), tree-parallel with virtual loss. Nodes come
+// from a fixed arena that lives as long as the engine; between moves the
+// subtree of the new position is kept when it is found within two plies.
+class MCTS {
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    MCTSConfig config;
+    std::unique_ptr<MCTSNode[]> arena;
+    std::atomic<size_t> next_node{0};
+
+    uint32_t root = NO_NODE;
+    Board root_board;
+    bool root_black = true;
+
+    steady_clock::time_point start_time;
+    int time_limit = 0;
+    std::atomic<int> max_depth{0};
+    std::atomic<uint64_t> total_playouts{0};
+    const std::atomic<bool>* stop_flag = nullptr;
+
+    struct Rng {
+        uint64_t state;
+        explicit Rng(uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ULL) {}
+        uint64_t next() { // xorshift64*
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545F4914F6CDD1DULL;
+        }
+    };
+
+public:
+    explicit MCTS(const MCTSConfig& cfg = MCTSConfig{}) : config(cfg), arena(new MCTSNode[cfg.max_nodes]) {
+        if (config.threads == 0) config.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void set_stop_flag(const std::atomic<bool>* flag) { stop_flag = flag; }
+
+    uint64_t playouts() const { return total_playouts; }
+    size_t nodes_used() const { return std::min(next_node.load(), config.max_nodes); }
+
+    // Same contract as Search::iterative_deepening. value is the expected
+    // result in per mille from black's point of view (+1000 = black wins),
+    // depth is the deepest selection path.
+    SearchResult search(const Board& board, bool is_black, int time_ms) {
+        start_time = steady_clock::now();
+        time_limit = time_ms;
+        max_depth = 0;
+        total_playouts = 0;
+        set_root(board, is_black);
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < config.threads; ++t) pool.emplace_back(&MCTS::worker, this, t);
+        worker(0);
+        for (auto& thread : pool) thread.join();
+
+        return best_result();
+    }
+
+private:
+    // Reuse the subtree for the new position if it is a child or grandchild
+    // of the previous root, otherwise start over. A half-full arena is
+    // recycled rather than risk running out mid-search.
+    void set_root(const Board& board, bool is_black) {
+        uint32_t reused = NO_NODE;
+        if (root != NO_NODE && next_node.load() < config.max_nodes / 2) {
+            reused = find_descendant(root, root_board, root_black, board, is_black, 2);
+        }
+
+        root_board = board;
+        root_black = is_black;
+        if (reused != NO_NODE) {
+            root = reused;
+            return;
+        }
+        next_node = 0;
+        root = allocate(1);
+        arena[root].init(0);
+    }
+
+    uint32_t find_descendant(uint32_t index, const Board& board, bool is_black,
+                             const Board& target, bool target_black, int plies) const {
+        if (board.black == target.black && board.white == target.white && is_black == target_black) return index;
+        const MCTSNode& node = arena[index];
+        if (plies == 0 || node.state.load(std::memory_order_acquire) != EXPANDED) return NO_NODE;
+
+        for (uint32_t i = 0; i < node.child_count; ++i) {
+            const uint32_t child = node.first_child + i;
+            Board next = board;
+            next.make_move(arena[child].move, is_black);
+            uint32_t found = find_descendant(child, next, !is_black, target, target_black, plies - 1);
+            if (found != NO_NODE) return found;
+        }
+        return NO_NODE;
+    }
+
+    uint32_t allocate(size_t count) {
+        const size_t first = next_node.fetch_add(count, std::memory_order_relaxed);
+        if (first + count > config.max_nodes) return NO_NODE;
+        return static_cast<uint32_t>(first);
+    }
+
+    bool should_stop() const {
+        if (stop_flag && stop_flag->load(std::memory_order_relaxed)) return true;
+        return duration_cast<milliseconds>(steady_clock::now() - start_time).count() >= time_limit;
+    }
+
+    void worker(unsigned thread_index) {
+        Rng rng(0xC0FFEEULL * (thread_index + 1) ^ static_cast<uint64_t>(start_time.time_since_epoch().count()));
+        std::vector<std::pair<uint32_t, bool>> path; // node, whether black played its move
+        path.reserve(64);
+
+        for (uint64_t iteration = 0; ; ++iteration) {
+            if ((iteration & 31) == 0 && should_stop()) break;
+            iterate(rng, path);
+        }
+    }
+
+    void iterate(Rng& rng, std::vector<std::pair<uint32_t, bool>>& path) {
+        const int vl = config.virtual_loss;
+        Board board = root_board;
+        bool is_black = root_black;
+
+        path.clear();
+        path.push_back({root, !is_black});
+        arena[root].virtual_visits.fetch_add(vl, std::memory_order_relaxed);
+
+        // Selection
+        uint32_t index = root;
+        while (arena[index].state.load(std::memory_order_acquire) == EXPANDED && arena[index].child_count) {
+            index = select_child(arena[index]);
+            arena[index].virtual_visits.fetch_add(vl, std::memory_order_relaxed);
+            path.push_back({index, is_black});
+            board.make_move(arena[index].move, is_black);
+            is_black = !is_black;
+        }
+
+        // Expansion: one thread claims the leaf, the others just play out from it
+        uint8_t expected = UNEXPANDED;
+        if (arena[index].state.compare_exchange_strong(expected, EXPANDING, std::memory_order_acquire)) {
+            expand(arena[index], board, is_black);
+        }
+
+        int depth = static_cast<int>(path.size()) - 1;
+        int seen = max_depth.load(std::memory_order_relaxed);
+        while (depth > seen && !max_depth.compare_exchange_weak(seen, depth)) {}
+
+        // Simulation, in one batch
+        const int batch = config.playouts_per_leaf;
+        int black_score = 0; // 2 per black win, 1 per draw
+        for (int i = 0; i < batch; ++i) {
+            const int diff = playout(board, is_black, rng);
+            black_score += diff > 0 ? 2 : diff == 0 ? 1 : 0;
+        }
+        total_playouts.fetch_add(batch, std::memory_order_relaxed);
+
+        // Backpropagation
+        for (const auto& [node, black_moved] : path) {
+            arena[node].visits.fetch_add(batch, std::memory_order_relaxed);
+            arena[node].virtual_visits.fetch_sub(vl, std::memory_order_relaxed);
+            arena[node].score.fetch_add(black_moved ? black_score : 2 * batch - black_score,
+                                        std::memory_order_relaxed);
+        }
+    }
+
+    // UCT; in-flight virtual visits count as losses
+    uint32_t select_child(const MCTSNode& parent) const {
+        const double parent_visits = parent.visits.load(std::memory_order_relaxed) +
+                                     parent.virtual_visits.load(std::memory_order_relaxed);
+        const double log_parent = std::log(std::max(1.0, parent_visits));
+
+        uint32_t best = parent.first_child;
+        double best_value = -1.0;
+        for (uint32_t i = 0; i < parent.child_count; ++i) {
+            const MCTSNode& child = arena[parent.first_child + i];
+            const double n = child.visits.load(std::memory_order_relaxed) +
+                             child.virtual_visits.load(std::memory_order_relaxed);
+            if (n == 0) return parent.first_child + i;
+
+            const double q = child.score.load(std::memory_order_relaxed) / (2.0 * n);
+            const double value = q + config.exploration * std::sqrt(log_parent / n);
+            if (value > best_value) {
+                best_value = value;
+                best = parent.first_child + i;
+            }
+        }
+        return best;
+    }
+
+    void expand(MCTSNode& node, const Board& board, bool is_black) {
+        uint64_t moves = board.get_move_mask(is_black);
+        const bool pass = !moves && board.get_move_mask(!is_black);
+        const int count = pass ? 1 : __builtin_popcountll(moves);
+
+        uint32_t first = 0;
+        if (count) {
+            first = allocate(count);
+            if (first == NO_NODE) { // arena full: leave it as a leaf
+                node.state.store(UNEXPANDED, std::memory_order_release);
+                return;
+            }
+            for (int i = 0; i < count; ++i) {
+                const uint64_t move = moves & -moves;
+                moves ^= move;
+                arena[first + i].init(move); // a pass gets move 0
+            }
+        }
+        node.first_child = first;
+        node.child_count = static_cast<uint16_t>(count);
+        node.state.store(EXPANDED, std::memory_order_release);
+    }
+
+    static uint64_t pick(uint64_t moves, Rng& rng) {
+        for (int k = rng.next() % __builtin_popcountll(moves); k > 0; --k) moves &= moves - 1;
+        return moves & -moves;
+    }
+
+    // Random game to the end; returns the black - white disc difference
+    int playout(Board board, bool is_black, Rng& rng) const {
+        int passes = 0;
+        while (passes < 2) {
+            uint64_t moves = board.get_move_mask(is_black);
+            if (!moves) {
+                ++passes;
+                is_black = !is_black;
+                continue;
+            }
+            passes = 0;
+            if (config.guided_playouts) {
+                if (moves & CORNERS) moves &= CORNERS;
+                else if (moves & ~X_SQUARES) moves &= ~X_SQUARES;
+            }
+            board.make_move(pick(moves, rng), is_black);
+            is_black = !is_black;
+        }
+        return __builtin_popcountll(board.black) - __builtin_popcountll(board.white);
+    }
+
+    SearchResult best_result() const {
+        SearchResult result;
+        result.depth = max_depth;
+        const MCTSNode& node = arena[root];
+        if (node.state.load(std::memory_order_acquire) != EXPANDED || node.child_count == 0) {
+            const uint64_t legal = root_board.get_move_mask(root_black);
+            result.move = legal & -legal;
+            return result;
+        }
+
+        const MCTSNode* best = nullptr;
+        for (uint32_t i = 0; i < node.child_count; ++i) {
+            const MCTSNode& child = arena[node.first_child + i];
+            if (!best || child.visits > best->visits) best = &child;
+        }
+        result.move = best->move;
+        const int visits = best->visits;
+        const double q = visits ? best->score / (2.0 * visits) : 0.5; // for the root player
+        const int value = static_cast<int>(std::lround((2 * q - 1) * 1000));
+        result.value = root_black ? value : -value;
+        return result;
+    }
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "board.hpp"
+#include "gameFormat.hpp"
+#include "zobrist.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// Read-only opening book: the most frequently played move for each position
+// seen in the first plies of a games file. Keys are canonical over the board
+// symmetries. Once built, lookups never modify the book, so one instance can
+// be shared by any number of threads.
+class OpeningBook {
+    struct Entry {
+        uint64_t key;
+        uint8_t square;   // in canonical orientation
+    };
+    std::vector<Entry> entries; // sorted by key
+
+public:
+    static constexpr int DEFAULT_PLIES = 16;
+
+    // Replace the book with one built from a games file (see gameFormat.hpp)
+    bool load_games(const std::string& path, int max_plies = DEFAULT_PLIES) {
+        GameFormat::GameReader reader(path);
+        if (!reader.is_open()) return false;
+
+        std::vector<std::pair<uint64_t, uint8_t>> seen; // (key, canonical square) per game move
+        reader.for_each([&](GameFormat::GameView game) {
+            game.length = std::min<size_t>(game.length, max_plies);
+            Board board;
+            GameFormat::replay(game, board, [&](const Board& b, bool is_black, uint64_t move) {
+                int sym = 0;
+                const uint64_t player = is_black ? b.black : b.white;
+                const uint64_t opponent = is_black ? b.white : b.black;
+                const uint64_t key = Zobrist::canonical_hash(player, opponent, sym);
+                seen.push_back({key, static_cast<uint8_t>(__builtin_ctzll(Board::transform(move, sym)))});
+            });
+        });
+        std::sort(seen.begin(), seen.end());
+
+        // Keep the most frequent move per key
+        entries.clear();
+        for (size_t i = 0; i < seen.size();) {
+            const uint64_t key = seen[i].first;
+            uint8_t best_square = seen[i].second;
+            size_t best_count = 0;
+            while (i < seen.size() && seen[i].first == key) {
+                size_t j = i;
+                while (j < seen.size() && seen[j] == seen[i]) ++j;
+                if (j - i > best_count) {
+                    best_count = j - i;
+                    best_square = seen[i].second;
+                }
+                i = j;
+            }
+            entries.push_back({key, best_square});
+        }
+        return true;
+    }
+
+    size_t size() const { return entries.size(); }
+
+    // Book move for the position, 0 if it is not in the book
+    uint64_t probe(const Board& board, bool is_black) const {
+        if (entries.empty()) return 0;
+
+        int sym = 0;
+        const uint64_t player = is_black ? board.black : board.white;
+        const uint64_t opponent = is_black ? board.white : board.black;
+        const uint64_t key = Zobrist::canonical_hash(player, opponent, sym);
+
+        auto it = std::lower_bound(entries.begin(), entries.end(), key,
+                                   [](const Entry& entry, uint64_t k) { return entry.key < k; });
+        if (it == entries.end() || it->key != key) return 0;
+
+        const uint64_t move = Board::inverse_transform(1ULL << it->square, sym);
+        return board.is_valid_move(move, is_black) ? move : 0; // guards against key collisions
+    }
+};
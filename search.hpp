@@ -1,14 +1,21 @@
 #pragma once
 
 #include "board.hpp"
+#include "endgameCache.hpp"
 #include "evaluation.hpp"
+#include "stability.hpp"
 #include "transPositionTable.hpp"
 #include "zobrist.hpp"
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <sys/types.h>
+#include <vector>
 
 
 #define DEBUG		0
@@ -30,35 +37,105 @@ struct SearchResult {
     int depth = 0;
 };
 
+// Progress report after each completed iteration
+struct SearchInfo {
+    static constexpr int MAX_PV = 16;
+    int depth = 0;
+    int value = 0;
+    uint64_t nodes = 0;
+    uint64_t nps = 0;
+    int pv_length = 0;
+    std::array<uint8_t, MAX_PV> pv{}; // square indices
+};
+
+
+// Bounds on the exact score of a position met during one endgame solve.
+// Keyed by the full position, so a hit is never a collision.
+struct SolveEntry {
+    uint64_t player = 0;
+    uint64_t opponent = 0;
+    int8_t lower = -64;
+    int8_t upper = 64;
+    uint8_t best_square = 0xFF;
+};
+
 
 class Search {
-    TranspositionTable tt;
+    static constexpr size_t SOLVE_TABLE_SIZE = 1 << 18; // entries, 6 MB, allocated on the first solve
+    static constexpr int SOLVE_TABLE_EMPTIES = 8;      // shallower nodes are cheaper to re-search
+    static constexpr int SOLVE_ORDER_EMPTIES = 7;      // fastest-first ordering from here up
+
+    std::unique_ptr<TranspositionTable> own_tt; // only when no table is passed in
+    TranspositionTable* tt;
+    EndgameCache* endgame_cache;
     steady_clock::time_point start_time;
     int time_limit;
     bool timeout = false;
+    bool interruptible = true; // false while depth 1 runs, so there is always a searched move
+    uint64_t nodes = 0;
+    const std::atomic<bool>* stop_flag = nullptr;
+    std::function<void(const SearchInfo&)> info_callback;
+    std::vector<SolveEntry> solve_table;
 
 public:
-    Search() {}
+    static constexpr int ENDGAME_EMPTIES = 16; // solve exactly from here on
+
+    // Without a table, the search allocates its own default-sized one
+    explicit Search(EndgameCache* cache = nullptr, TranspositionTable* table = nullptr)
+        : own_tt(table ? nullptr : std::make_unique<TranspositionTable>()),
+          tt(table ? table : own_tt.get()),
+          endgame_cache(cache) {}
+
+    // Setting the flag from another thread ends the search at the next node
+    // (after depth 1 at the earliest); the result of the last completed
+    // iteration is returned.
+    void set_stop_flag(const std::atomic<bool>* flag) { stop_flag = flag; }
+
+    // Called on the search thread after every completed iteration
+    void set_info_callback(std::function<void(const SearchInfo&)> callback) {
+        info_callback = std::move(callback);
+    }
 
     SearchResult iterative_deepening(Board& board, bool is_black, int time_ms, int max_depth) {
         start_time = steady_clock::now();
         time_limit = time_ms;
         timeout = false;
-        tt.new_search();
+        nodes = 0;
+        tt->new_search();
 
+        // Fallback when no iteration runs; otherwise depth 1 replaces it
         SearchResult best_result;
+        const uint64_t legal = board.get_move_mask(is_black);
+        best_result.move = legal & -legal;
+
+        const int empties = 64 - __builtin_popcountll(board.black | board.white);
+        if (empties <= ENDGAME_EMPTIES) {
+            // Give the exact solve half the budget, fall back to the heuristic search
+            time_limit = time_ms / 2;
+            if (solve_root(board, is_black, best_result)) {
+                report(board, is_black, best_result);
+                return best_result;
+            }
+            time_limit = time_ms;
+            timeout = false;
+        }
+
         uint64_t board_hash = Zobrist::compute_hash(board, is_black);
 
         for (int depth = 1; depth <= max_depth; ++depth) {
             int alpha = -INF;
             int beta = INF;
 
+            // Depth 1 always completes, even when stopped during the endgame solve
+            interruptible = depth > 1;
             SearchResult current = alpha_beta(board, board_hash, depth, alpha, beta, is_black);
+            interruptible = true;
 
             if (timeout) break;
 
             best_result = current;
             best_result.depth = depth;
+            report(board, is_black, best_result);
 
             // Early exit if game is decided
             if(abs(current.value) > INF/2) break;
@@ -67,8 +144,188 @@ public:
     }
 
 private:
+    void report(const Board& root, bool is_black, const SearchResult& result) {
+        if (!info_callback) return;
+
+        SearchInfo info;
+        info.depth = result.depth;
+        info.value = result.value;
+        info.nodes = nodes;
+        const auto elapsed_us = duration_cast<microseconds>(steady_clock::now() - start_time).count();
+        info.nps = elapsed_us > 0 ? nodes * 1000000 / elapsed_us : 0;
+
+        // Principal variation: the root move, then best moves from the TT
+        Board board = root;
+        uint64_t hash = Zobrist::compute_hash(root, is_black);
+        uint64_t move = result.move;
+        while (move && info.pv_length < SearchInfo::MAX_PV && board.is_valid_move(move, is_black)) {
+            info.pv[info.pv_length++] = __builtin_ctzll(move);
+            Board next = board;
+            next.make_move(move, is_black);
+            hash = Zobrist::update_hash(hash, board, next);
+            board = next;
+            is_black = !is_black;
+            move = tt->best_move(hash);
+        }
+        info_callback(info);
+    }
+
+    // Exact disc difference mapped onto the search scale: wins and losses
+    // dominate any heuristic score, draws stay neutral.
+    static int endgame_value(int disc_diff_black) {
+        if (disc_diff_black > 0) return INF / 2 + disc_diff_black;
+        if (disc_diff_black < 0) return -INF / 2 + disc_diff_black;
+        return 0;
+    }
+
+    bool solve_root(const Board& board, bool is_black, SearchResult& result) {
+        if (solve_table.empty()) solve_table.resize(SOLVE_TABLE_SIZE);
+        uint64_t best_move = 0;
+        int score = solve_endgame(board, is_black, -64, 64, false, best_move);
+        if (timeout) return false;
+
+        result.move = best_move;
+        result.value = endgame_value(is_black ? score : -score);
+        result.depth = 64 - __builtin_popcountll(board.black | board.white);
+        return true;
+    }
+
+    // Negamax to the end of the game; returns the final disc difference for the
+    // side to move. Results inside the window are exact and go to the endgame cache.
+    int solve_endgame(const Board& board, bool is_black, int alpha, int beta, bool passed, uint64_t& best_move) {
+        best_move = 0;
+        if (check_timeout()) return 0;
+        ++nodes;
+
+        const uint64_t player = is_black ? board.black : board.white;
+        const uint64_t opponent = is_black ? board.white : board.black;
+        const int empties = 64 - __builtin_popcountll(player | opponent);
+
+        const bool cacheable = endgame_cache && empties >= EndgameCache::MIN_EMPTIES;
+        int cached;
+        if (cacheable && endgame_cache->probe(player, opponent, cached, best_move)) {
+            return cached;
+        }
+
+        // Bounds from earlier in this solve narrow the window or settle the node
+        SolveEntry* entry = nullptr;
+        uint64_t hint = 0;
+        if (empties >= SOLVE_TABLE_EMPTIES) {
+            entry = &solve_table[solve_index(player, opponent)];
+            if (entry->player == player && entry->opponent == opponent) {
+                if (entry->lower >= beta || entry->lower == entry->upper) return entry->lower;
+                if (entry->upper <= alpha) return entry->upper;
+                alpha = std::max<int>(alpha, entry->lower);
+                beta = std::min<int>(beta, entry->upper);
+                if (entry->best_square < 64) hint = 1ULL << entry->best_square;
+            }
+        }
+
+        // Stability cutoff: the opponent keeps its stable discs, which caps
+        // our final score; skip the kernel when it can't possibly fail low
+        if (64 - 2 * __builtin_popcountll(opponent) <= alpha) {
+            const int upper = 64 - 2 * Stability::count_stable(opponent, player);
+            if (upper <= alpha) return upper;
+        }
+
+        uint64_t moves = board.get_move_mask(is_black);
+        if (!moves) {
+            if (passed) {
+                // Game over, empty squares go to the winner
+                int diff = __builtin_popcountll(player) - __builtin_popcountll(opponent);
+                return diff > 0 ? diff + empties : diff < 0 ? diff - empties : 0;
+            }
+            uint64_t unused;
+            return -solve_endgame(board, !is_black, -beta, -alpha, true, unused);
+        }
+
+        std::array<uint64_t, 32> ordered;
+        const int count = order_solve_moves(board, is_black, moves, hint, empties, ordered);
+
+        const int alpha_orig = alpha;
+        int best = -65;
+        for (int i = 0; i < count; ++i) {
+            const uint64_t move = ordered[i];
+            Board new_board = board;
+            new_board.make_move(move, is_black);
+
+            // Principal variation search: after the first move, prove each
+            // move is no better with a null window, re-search when it is
+            uint64_t unused;
+            int score;
+            if (i == 0) {
+                score = -solve_endgame(new_board, !is_black, -beta, -alpha, false, unused);
+            } else {
+                score = -solve_endgame(new_board, !is_black, -alpha - 1, -alpha, false, unused);
+                if (score > alpha && score < beta && !timeout) {
+                    score = -solve_endgame(new_board, !is_black, -beta, -score, false, unused);
+                }
+            }
+            if (timeout) return 0;
+
+            if (score > best) {
+                best = score;
+                best_move = move;
+                alpha = std::max(alpha, best);
+                if (alpha >= beta) break;
+            }
+        }
+
+        if (entry) {
+            if (entry->player != player || entry->opponent != opponent) *entry = SolveEntry{player, opponent};
+            if (best > alpha_orig) entry->lower = static_cast<int8_t>(best);
+            if (best < beta) entry->upper = static_cast<int8_t>(best);
+            entry->best_square = static_cast<uint8_t>(__builtin_ctzll(best_move));
+        }
+        if (cacheable && best > alpha_orig && best < beta) {
+            endgame_cache->store(player, opponent, best, best_move);
+        }
+        return best;
+    }
+
+    size_t solve_index(uint64_t player, uint64_t opponent) const {
+        uint64_t h = player * 0x9E3779B97F4A7C15ULL ^ opponent * 0xC2B2AE3D27D4EB4FULL;
+        return (h ^ h >> 29) & (solve_table.size() - 1);
+    }
+
+    // Fastest first: moves that leave the opponent the fewest replies (and no
+    // corners), own corners ahead of ties, the table's best move before all. Near the end the plain
+    // square order is cheaper than sorting.
+    static int order_solve_moves(const Board& board, bool is_black, uint64_t moves, uint64_t hint,
+                                 int empties, std::array<uint64_t, 32>& ordered) {
+        int count = 0;
+        if (empties < SOLVE_ORDER_EMPTIES) {
+            if (moves & hint) ordered[count++] = hint;
+            for (moves &= ~hint; moves; moves &= moves - 1) ordered[count++] = moves & -moves;
+            return count;
+        }
+
+        std::array<int, 32> keys;
+        for (; moves; moves &= moves - 1) {
+            const uint64_t move = moves & -moves;
+            Board next = board;
+            next.make_move(move, is_black);
+            const uint64_t replies = next.get_move_mask(!is_black);
+            int key = 4 * __builtin_popcountll(replies) + 4 * __builtin_popcountll(replies & CORNERS) -
+                      (move & CORNERS ? 2 : 0);
+            if (move == hint) key = INT_MIN;
+
+            // Insertion sort, the lists are short
+            int i = count++;
+            while (i > 0 && keys[i - 1] > key) {
+                keys[i] = keys[i - 1];
+                ordered[i] = ordered[i - 1];
+                --i;
+            }
+            keys[i] = key;
+            ordered[i] = move;
+        }
+        return count;
+    }
+
     SearchResult alpha_beta(Board& board, uint64_t hash, int depth, int alpha, int beta, bool is_black_turn) {
         if (check_timeout()) return {0, 0, depth};
+        ++nodes;
 
         pr("Entering alpha_beta\n");
 
@@ -78,11 +335,23 @@ private:
         uint64_t tt_move = 0;
 
         pr("Before probing TT\n");
-        if (tt.probe(hash, depth, tt_alpha, tt_beta, tt_value, tt_move)) {
+        if (tt->probe(hash, depth, tt_alpha, tt_beta, tt_value, tt_move)) {
             pr("TT Hit\n");
             return {tt_move, tt_value, depth};
         }
 
+        // Solved endgames sit behind the TT
+        const int empties = 64 - __builtin_popcountll(board.black | board.white);
+        if (endgame_cache && empties <= ENDGAME_EMPTIES && empties >= EndgameCache::MIN_EMPTIES) {
+            const uint64_t player = is_black_turn ? board.black : board.white;
+            const uint64_t opponent = is_black_turn ? board.white : board.black;
+            int score;
+            uint64_t solved_move;
+            if (endgame_cache->probe(player, opponent, score, solved_move)) {
+                return {solved_move, endgame_value(is_black_turn ? score : -score), depth};
+            }
+        }
+
         pr("Before getting moves\n");
         vector<uint64_t> moves = board.get_moves(is_black_turn);
         pr("Got moves %zu\n", moves.size());
@@ -106,13 +375,12 @@ private:
             Board new_board = board;
             new_board.make_move(move, is_black_turn);
 
-            int square = __builtin_ctzll(move); // Count trailing zeros
-            uint64_t new_hash = hash ^ Zobrist::zobrist_data.squares[square][is_black_turn ? 0 : 1];
-            new_hash ^= Zobrist::zobrist_data.black_to_move;
+            uint64_t new_hash = Zobrist::update_hash(hash, board, new_board);
 
             SearchResult current;
             if (depth == 1) {
                 current.value = evaluate(new_board);
+                ++nodes;
             } else {
                 current = alpha_beta(new_board, new_hash, depth - 1, alpha, beta, !is_black_turn);
             }
@@ -142,11 +410,15 @@ private:
         else if (best_result.value >= tt_beta) tt_type = EntryType::LOWERBOUND;
         else tt_type = EntryType::EXACT;
 
-        tt.store(hash, depth, best_result.value, tt_type, best_result.move);
+        tt->store(hash, depth, best_result.value, tt_type, best_result.move);
         return best_result;
     }
 
     bool check_timeout() {
+        if (!interruptible) return false;
+        if (!timeout && stop_flag && stop_flag->load(std::memory_order_relaxed)) {
+            timeout = true;
+        }
         if (!timeout && duration_cast<milliseconds>(steady_clock::now() - start_time).count() > time_limit) {
             timeout = true;
         }
@@ -0,0 +1,85 @@
+// Plays the alpha-beta engine against MCTS, alternating colors.
+// Usage: othello_selfplay [games] [time_ms] [games.ogm]
+#include "board.hpp"
+#include "endgameCache.hpp"
+#include "gameFormat.hpp"
+#include "mcts.hpp"
+#include "search.hpp"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using std::cout;
+
+struct Engine {
+    std::string name;
+    std::function<SearchResult(const Board&, bool)> choose_move;
+};
+
+// Returns the final black - white disc difference; records the moves played
+int play_game(Engine& black, Engine& white, std::vector<uint8_t>& squares) {
+    Board board;
+    bool is_black = true;
+    squares.clear();
+
+    while (!board.is_game_over()) {
+        if (!board.get_move_mask(is_black)) {
+            is_black = !is_black;
+            continue;
+        }
+        Engine& engine = is_black ? black : white;
+        SearchResult result = engine.choose_move(board, is_black);
+        if (!board.is_valid_move(result.move, is_black)) {
+            std::cerr << engine.name << " played an illegal move " << move_to_notation(result.move) << "\n";
+            std::exit(1);
+        }
+        board.make_move(result.move, is_black);
+        squares.push_back(__builtin_ctzll(result.move));
+        is_black = !is_black;
+    }
+    return __builtin_popcountll(board.black) - __builtin_popcountll(board.white);
+}
+
+int main(int argc, char** argv) {
+    const int games = argc > 1 ? std::atoi(argv[1]) : 10;
+    const int time_ms = argc > 2 ? std::atoi(argv[2]) : 200;
+    const int MAX_DEPTH = 60;
+
+    EndgameCache endgame_cache;
+    MCTS mcts;
+
+    Engine alpha_beta{"alpha-beta", [&](const Board& board, bool is_black) {
+        Board copy = board;
+        Search searcher(&endgame_cache);
+        return searcher.iterative_deepening(copy, is_black, time_ms, MAX_DEPTH);
+    }};
+    Engine monte_carlo{"mcts", [&](const Board& board, bool is_black) {
+        return mcts.search(board, is_black, time_ms);
+    }};
+
+    std::unique_ptr<GameFormat::GameWriter> writer;
+    if (argc > 3) writer = std::make_unique<GameFormat::GameWriter>(argv[3]);
+
+    int alpha_beta_wins = 0, mcts_wins = 0, draws = 0;
+    std::vector<uint8_t> squares;
+    for (int game = 0; game < games; ++game) {
+        const bool alpha_beta_black = game % 2 == 0;
+        Engine& black = alpha_beta_black ? alpha_beta : monte_carlo;
+        Engine& white = alpha_beta_black ? monte_carlo : alpha_beta;
+
+        const int diff = play_game(black, white, squares);
+        const int alpha_beta_diff = alpha_beta_black ? diff : -diff;
+        if (alpha_beta_diff > 0) ++alpha_beta_wins;
+        else if (alpha_beta_diff < 0) ++mcts_wins;
+        else ++draws;
+        if (writer) writer->write(GameFormat::view(squares));
+
+        cout << "Game " << game + 1 << ": " << black.name << " (black) vs " << white.name
+             << " (white): " << (diff > 0 ? "+" : "") << diff << "\n";
+    }
+
+    cout << "\nalpha-beta " << alpha_beta_wins << "  mcts " << mcts_wins << "  draws " << draws << "\n";
+    return 0;
+}
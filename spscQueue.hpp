@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Lock-free ring buffer for exactly one producer thread and one consumer thread.
+// T should be trivially copyable; a full queue rejects the push.
+template<typename T, size_t N>
+class SpscQueue {
+    static_assert(N && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    alignas(64) std::atomic<size_t> head{0}; // next slot to read, written by the consumer
+    alignas(64) std::atomic<size_t> tail{0}; // next slot to write, written by the producer
+    std::array<T, N> slots;
+
+public:
+    bool push(const T& item) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == N) return false;
+        slots[t & (N - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = slots[h & (N - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "tables.hpp"
+#include <cstdint>
+
+// Stable discs: discs that can never be flipped for the rest of the game.
+// The result is a lower bound on the true stable set (it never reports a
+// disc that could still flip).
+namespace Stability {
+    constexpr uint64_t FILE_A_H  = 0x8181818181818181ULL; // no horizontal neighbour on one side
+    constexpr uint64_t RANK_1_8  = 0xFF000000000000FFULL; // no vertical neighbour on one side
+    constexpr uint64_t BORDER    = 0xFF818181818181FFULL; // no diagonal neighbour on one side
+
+    struct FullLines {
+        uint64_t horizontal, vertical, diagonal, anti_diagonal;
+    };
+
+    // Squares whose line along each axis has no empty square left.
+    // A disc on a full line can't be flipped along that line.
+    inline FullLines full_lines(uint64_t occupied) {
+        FullLines full;
+
+        // Fold each row into its a-file bit, then spread it back over the row
+        uint64_t h = occupied & (occupied >> 1);
+        h &= h >> 2;
+        h &= h >> 4;
+        full.horizontal = (h & 0x0101010101010101ULL) * 0xFF;
+
+        // Fold each column into rank 1, then spread it back down the column
+        uint64_t v = occupied & (occupied >> 8);
+        v &= v >> 16;
+        v &= v >> 32;
+        full.vertical = (v & 0xFF) * 0x0101010101010101ULL;
+
+        full.diagonal = 0;
+        full.anti_diagonal = 0;
+        for (int i = 0; i < 15; ++i) {
+            const uint64_t d = Tables::DIAGONALS[i];
+            const uint64_t a = Tables::ANTI_DIAGONALS[i];
+            if ((occupied & d) == d) full.diagonal |= d;
+            if ((occupied & a) == a) full.anti_diagonal |= a;
+        }
+        return full;
+    }
+
+    // A disc is stable when, along each of the four axes, its line is full or
+    // one of its two neighbours is the board edge or a stable disc of the same
+    // color. Starting from nothing, this grows from the corners along the
+    // edges and inwards until it stops changing.
+    inline uint64_t stable_discs(uint64_t player, uint64_t opponent) {
+        using namespace Tables;
+        const FullLines full = full_lines(player | opponent);
+        const uint64_t h_base = full.horizontal | FILE_A_H;
+        const uint64_t v_base = full.vertical | RANK_1_8;
+        const uint64_t d_base = full.diagonal | BORDER;
+        const uint64_t a_base = full.anti_diagonal | BORDER;
+
+        uint64_t stable = 0;
+        uint64_t previous;
+        do {
+            previous = stable;
+            const uint64_t h = h_base | shift(stable, LEFT) | shift(stable, RIGHT);
+            const uint64_t v = v_base | shift(stable, UP) | shift(stable, DOWN);
+            const uint64_t d = d_base | shift(stable, UP_LEFT) | shift(stable, DOWN_RIGHT);
+            const uint64_t a = a_base | shift(stable, UP_RIGHT) | shift(stable, DOWN_LEFT);
+            stable = player & h & v & d & a;
+        } while (stable != previous);
+
+        return stable;
+    }
+
+    inline int count_stable(uint64_t player, uint64_t opponent) {
+        return __builtin_popcountll(stable_discs(player, opponent));
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Board geometry tables, generated at compile time into read-only storage
+namespace Tables {
+    // Direction order matches Board::shift
+    enum Direction { UP, DOWN, RIGHT, LEFT, UP_LEFT, UP_RIGHT, DOWN_LEFT, DOWN_RIGHT };
+
+    constexpr uint64_t shift(uint64_t mask, int dir) {
+        switch (dir) {
+            case UP:         return (mask >> 8) & 0x00FFFFFFFFFFFFFF;
+            case DOWN:       return (mask << 8) & 0xFFFFFFFFFFFFFF00;
+            case RIGHT:      return (mask & 0x7F7F7F7F7F7F7F7F) << 1;
+            case LEFT:       return (mask & 0xFEFEFEFEFEFEFEFE) >> 1;
+            case UP_LEFT:    return (mask & 0xFEFEFEFEFEFEFEFE) >> 9;
+            case UP_RIGHT:   return (mask & 0x7F7F7F7F7F7F7F7F) >> 7;
+            case DOWN_LEFT:  return (mask & 0xFEFEFEFEFEFEFEFE) << 7;
+            case DOWN_RIGHT: return (mask & 0x7F7F7F7F7F7F7F7F) << 9;
+            default: return 0;
+        }
+    }
+
+    // Directions that walk towards higher bit indices
+    constexpr bool is_increasing(int dir) {
+        return dir == DOWN || dir == RIGHT || dir == DOWN_LEFT || dir == DOWN_RIGHT;
+    }
+
+    using RayTable = std::array<std::array<uint64_t, 64>, 8>;
+
+    // RAYS[dir][sq]: every square reached from sq in dir, sq itself excluded
+    constexpr RayTable generate_rays() {
+        RayTable rays{};
+        for (int dir = 0; dir < 8; ++dir) {
+            for (int sq = 0; sq < 64; ++sq) {
+                uint64_t cursor = shift(1ULL << sq, dir);
+                while (cursor) {
+                    rays[dir][sq] |= cursor;
+                    cursor = shift(cursor, dir);
+                }
+            }
+        }
+        return rays;
+    }
+
+    alignas(64) inline constexpr RayTable RAYS = generate_rays();
+
+    using LineTable = std::array<uint64_t, 15>;
+
+    // The 15 diagonals (a1-h8 direction) indexed by row - col + 7,
+    // and the 15 anti-diagonals (h1-a8 direction) indexed by row + col
+    constexpr LineTable generate_diagonals(bool anti) {
+        LineTable lines{};
+        for (int sq = 0; sq < 64; ++sq) {
+            const int row = sq / 8, col = sq % 8;
+            lines[anti ? row + col : row - col + 7] |= 1ULL << sq;
+        }
+        return lines;
+    }
+
+    alignas(64) inline constexpr LineTable DIAGONALS = generate_diagonals(false);
+    alignas(64) inline constexpr LineTable ANTI_DIAGONALS = generate_diagonals(true);
+
+    static_assert(RAYS[RIGHT][0] == 0xFEULL, "a1 ray to the right covers b1-h1");
+    static_assert(RAYS[DOWN_RIGHT][0] == 0x8040201008040200ULL, "a1 diagonal");
+    static_assert(DIAGONALS[7] == 0x8040201008040201ULL, "a1-h8 main diagonal");
+    static_assert(ANTI_DIAGONALS[7] == 0x0102040810204080ULL, "h1-a8 main anti-diagonal");
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// Helpers shared by the tests/ programs: CHECK records a failure and keeps
+// going, test_result() turns the count into an exit code, and random_game()
+// plays random legal moves from the start position.
+
+#include "board.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+inline int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { ++failures; fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+                   fprintf(stderr, __VA_ARGS__); fprintf(stderr, "\n"); } } while (0)
+
+// Return value for main(); detail is appended to the success line
+inline int test_result(const char* name, const std::string& detail = "") {
+    if (failures) {
+        fprintf(stderr, "%d failure(s)\n", failures);
+        return 1;
+    }
+    printf("%s: all tests passed%s\n", name, detail.empty() ? "" : (" (" + detail + ")").c_str());
+    return 0;
+}
+
+// One random game from the start position. visit(board, is_black) sees every
+// position before its side to move plays or passes, and the final position;
+// returning false ends the game there. Returns the squares played.
+template<typename Visit>
+std::vector<uint8_t> random_game(std::mt19937_64& rng, Visit&& visit) {
+    std::vector<uint8_t> squares;
+    Board board;
+    bool is_black = true;
+    while (visit(static_cast<const Board&>(board), is_black) && !board.is_game_over()) {
+        const auto moves = board.get_moves(is_black);
+        if (!moves.empty()) {
+            const uint64_t move = moves[rng() % moves.size()];
+            board.make_move(move, is_black);
+            squares.push_back(static_cast<uint8_t>(__builtin_ctzll(move)));
+        }
+        is_black = !is_black;
+    }
+    return squares;
+}
+
+inline std::vector<uint8_t> random_game(std::mt19937_64& rng) {
+    return random_game(rng, [](const Board&, bool) { return true; });
+}
+
+// A fresh file under /tmp, so concurrent test runs don't share paths; the
+// caller removes it
+inline std::string temp_path(const char* name) {
+    std::string path = std::string("/tmp/othello_") + name + "_XXXXXX";
+    const int fd = mkstemp(path.data());
+    if (fd >= 0) close(fd);
+    return path;
+}
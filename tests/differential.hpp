@@ -0,0 +1,75 @@
+#pragma once
+
+// Compares one position between Board and the reference implementation.
+// Shared by the random-game test and the fuzz target.
+
+#include "board.hpp"
+#include "reference.hpp"
+#include "zobrist.hpp"
+#include <cstdio>
+#include <string>
+
+namespace Differential {
+    // Describes the first mismatch, or returns an empty string
+    inline std::string compare_position(const Board& board) {
+        const Reference::Position pos = Reference::from_bitboards(board.black, board.white);
+        char buffer[160];
+        auto fail = [&](const char* what, bool is_black) {
+            snprintf(buffer, sizeof(buffer), "%s (%s to move) black %016llx white %016llx", what,
+                     is_black ? "black" : "white",
+                     static_cast<unsigned long long>(board.black), static_cast<unsigned long long>(board.white));
+            return std::string(buffer);
+        };
+
+        for (int side = 0; side < 2; ++side) {
+            const bool is_black = side == 0;
+            const int color = is_black ? Reference::BLACK : Reference::WHITE;
+
+            // Legal moves, through all three bitboard entry points
+            const auto expected = Reference::legal_moves(pos, color);
+            uint64_t expected_mask = 0;
+            for (int sq : expected) expected_mask |= 1ULL << sq;
+
+            if (board.get_move_mask(is_black) != expected_mask) return fail("get_move_mask", is_black);
+            const auto moves = board.get_moves(is_black);
+            if (moves.size() != expected.size()) return fail("get_moves count", is_black);
+            for (size_t i = 0; i < moves.size(); ++i) {
+                if (moves[i] != 1ULL << expected[i]) return fail("get_moves order", is_black);
+            }
+            for (int sq = 0; sq < 64; ++sq) {
+                if (board.is_valid_move(1ULL << sq, is_black) != (((expected_mask >> sq) & 1) != 0)) {
+                    return fail("is_valid_move", is_black);
+                }
+            }
+
+            // Flips of every legal move
+            for (int sq : expected) {
+                Board next = board;
+                next.make_move(1ULL << sq, is_black);
+                Reference::Position ref = pos;
+                Reference::play(ref, sq, color);
+                uint64_t black, white;
+                Reference::to_bitboards(ref, black, white);
+                if (next.black != black || next.white != white) return fail("make_move", is_black);
+            }
+
+            if (Zobrist::compute_hash(board, is_black) != Reference::hash(pos, is_black)) {
+                return fail("compute_hash", is_black);
+            }
+        }
+
+        if (board.is_game_over() != Reference::game_over(pos)) return fail("is_game_over", true);
+        return "";
+    }
+
+    inline std::string compare_shift(uint64_t mask) {
+        for (int dir = 0; dir < 8; ++dir) {
+            if (Board::shift(mask, dir) != Reference::shift(mask, dir)) {
+                char buffer[80];
+                snprintf(buffer, sizeof(buffer), "shift dir %d mask %016llx", dir, static_cast<unsigned long long>(mask));
+                return buffer;
+            }
+        }
+        return "";
+    }
+}
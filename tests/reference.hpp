@@ -0,0 +1,118 @@
+#pragma once
+
+// Slow, obviously-correct Othello on an 8x8 array, for differential testing
+// of the bitboard code. Squares are row * 8 + col (a1 = 0, h8 = 63) and the
+// directions follow Board::shift.
+
+#include "zobrist.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Reference {
+    enum Cell { EMPTY, BLACK, WHITE };
+
+    const int DR[8] = {-1, 1, 0,  0, -1, -1, 1, 1}; // up, down, right, left, up-left, up-right, down-left, down-right
+    const int DC[8] = { 0, 0, 1, -1, -1,  1, -1, 1};
+
+    struct Position {
+        int cells[8][8];
+    };
+
+    inline bool on_board(int row, int col) {
+        return row >= 0 && row < 8 && col >= 0 && col < 8;
+    }
+
+    inline Position from_bitboards(uint64_t black, uint64_t white) {
+        Position pos;
+        for (int row = 0; row < 8; ++row) {
+            for (int col = 0; col < 8; ++col) {
+                const int sq = row * 8 + col;
+                pos.cells[row][col] = (black >> sq) & 1 ? BLACK : (white >> sq) & 1 ? WHITE : EMPTY;
+            }
+        }
+        return pos;
+    }
+
+    inline void to_bitboards(const Position& pos, uint64_t& black, uint64_t& white) {
+        black = white = 0;
+        for (int row = 0; row < 8; ++row) {
+            for (int col = 0; col < 8; ++col) {
+                const uint64_t bit = 1ULL << (row * 8 + col);
+                if (pos.cells[row][col] == BLACK) black |= bit;
+                if (pos.cells[row][col] == WHITE) white |= bit;
+            }
+        }
+    }
+
+    // Square one step from sq in dir, or -1 off the board
+    inline int step(int sq, int dir) {
+        const int row = sq / 8 + DR[dir], col = sq % 8 + DC[dir];
+        return on_board(row, col) ? row * 8 + col : -1;
+    }
+
+    // Squares that playing (row, col) would flip, walking each direction
+    inline std::vector<int> flips(const Position& pos, int row, int col, int color) {
+        std::vector<int> result;
+        if (pos.cells[row][col] != EMPTY) return result;
+        const int other = color == BLACK ? WHITE : BLACK;
+
+        for (int dir = 0; dir < 8; ++dir) {
+            std::vector<int> line;
+            int r = row + DR[dir], c = col + DC[dir];
+            while (on_board(r, c) && pos.cells[r][c] == other) {
+                line.push_back(r * 8 + c);
+                r += DR[dir];
+                c += DC[dir];
+            }
+            if (!line.empty() && on_board(r, c) && pos.cells[r][c] == color) {
+                result.insert(result.end(), line.begin(), line.end());
+            }
+        }
+        return result;
+    }
+
+    inline bool is_legal(const Position& pos, int sq, int color) {
+        return !flips(pos, sq / 8, sq % 8, color).empty();
+    }
+
+    inline std::vector<int> legal_moves(const Position& pos, int color) {
+        std::vector<int> moves;
+        for (int sq = 0; sq < 64; ++sq) {
+            if (is_legal(pos, sq, color)) moves.push_back(sq);
+        }
+        return moves;
+    }
+
+    inline void play(Position& pos, int sq, int color) {
+        for (int flipped : flips(pos, sq / 8, sq % 8, color)) {
+            pos.cells[flipped / 8][flipped % 8] = color;
+        }
+        pos.cells[sq / 8][sq % 8] = color;
+    }
+
+    inline bool game_over(const Position& pos) {
+        return legal_moves(pos, BLACK).empty() && legal_moves(pos, WHITE).empty();
+    }
+
+    // Zobrist hash from scratch: XOR the key of every occupied square
+    inline uint64_t hash(const Position& pos, bool black_to_move) {
+        uint64_t h = 0;
+        for (int sq = 0; sq < 64; ++sq) {
+            const int cell = pos.cells[sq / 8][sq % 8];
+            if (cell == BLACK) h ^= Zobrist::zobrist_table[sq][0];
+            if (cell == WHITE) h ^= Zobrist::zobrist_table[sq][1];
+        }
+        return black_to_move ? h ^ Zobrist::black_to_move_key : h;
+    }
+
+    // Every set square moved one step in dir; squares leaving the board vanish
+    inline uint64_t shift(uint64_t mask, int dir) {
+        uint64_t result = 0;
+        for (int sq = 0; sq < 64; ++sq) {
+            if (!((mask >> sq) & 1)) continue;
+            const int to = step(sq, dir);
+            if (to >= 0) result |= 1ULL << to;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,92 @@
+// Differential test of the bitboard core against the array reference in
+// reference.hpp: legal moves, flips, hashes and game over along random games,
+// plus arbitrary (not necessarily reachable) bitboard pairs.
+// Usage: test_differential [positions]   (default 1000000)
+#include "board.hpp"
+#include "check.hpp"
+#include "differential.hpp"
+#include "reference.hpp"
+#include "zobrist.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+static const int MAX_REPORTED = 20; // stop a test early once it is clearly broken
+
+// Random mask with roughly 1/2, 1/4 or 1/8 of the squares set
+static uint64_t random_mask(std::mt19937_64& rng) {
+    uint64_t mask = rng();
+    for (int k = rng() % 3; k > 0; --k) mask &= rng();
+    return mask;
+}
+
+static void test_shift(std::mt19937_64& rng) {
+    for (int sq = 0; sq < 64; ++sq) {
+        const std::string error = Differential::compare_shift(1ULL << sq);
+        CHECK(error.empty(), "%s", error.c_str());
+    }
+    for (int i = 0; i < 100000 && failures < MAX_REPORTED; ++i) {
+        const std::string error = Differential::compare_shift(random_mask(rng));
+        CHECK(error.empty(), "%s", error.c_str());
+    }
+}
+
+// Random games from the start position; returns the number of positions checked
+static long test_random_games(std::mt19937_64& rng, long target) {
+    long positions = 0;
+    while (positions < target && failures < MAX_REPORTED) {
+        Board previous;
+        uint64_t hash = 0;
+        bool started = false;
+
+        random_game(rng, [&](const Board& board, bool is_black) {
+            // Every step is a move or a pass, so the hash follows incrementally
+            hash = started ? Zobrist::update_hash(hash, previous, board) : Zobrist::compute_hash(board, is_black);
+            started = true;
+            previous = board;
+
+            const std::string error = Differential::compare_position(board);
+            CHECK(error.empty(), "%s", error.c_str());
+            ++positions;
+
+            const Reference::Position pos = Reference::from_bitboards(board.black, board.white);
+            CHECK(hash == Reference::hash(pos, is_black), "incremental hash drifted after %d discs",
+                  __builtin_popcountll(board.black | board.white));
+
+            // Symmetric positions share a canonical key
+            int sym = 0, transformed_sym = 0;
+            const int s = rng() % 8;
+            const uint64_t player = is_black ? board.black : board.white;
+            const uint64_t opponent = is_black ? board.white : board.black;
+            CHECK(Zobrist::canonical_hash(player, opponent, sym) ==
+                  Zobrist::canonical_hash(Board::transform(player, s), Board::transform(opponent, s), transformed_sym),
+                  "canonical_hash differs under symmetry %d", s);
+            return failures < MAX_REPORTED;
+        });
+    }
+    return positions;
+}
+
+static void test_random_bitboards(std::mt19937_64& rng, long count) {
+    for (long i = 0; i < count && failures < MAX_REPORTED; ++i) {
+        Board board;
+        board.black = random_mask(rng);
+        board.white = random_mask(rng) & ~board.black;
+        const std::string error = Differential::compare_position(board);
+        CHECK(error.empty(), "%s", error.c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    const long positions = argc > 1 ? std::atol(argv[1]) : 1000000;
+    std::mt19937_64 rng(20240601);
+
+    test_shift(rng);
+    const long played = test_random_games(rng, positions);
+    test_random_bitboards(rng, positions / 10);
+
+    char detail[96];
+    snprintf(detail, sizeof(detail), "%ld game positions, %ld random pairs", played, positions / 10);
+    return test_result("differential", detail);
+}
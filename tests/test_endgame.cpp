@@ -0,0 +1,77 @@
+// Exact endgame solver: scores and moves against a plain alpha-beta, and the
+// endgame cache giving the same answers on a second solve
+#include "board.hpp"
+#include "check.hpp"
+#include "endgameCache.hpp"
+#include "search.hpp"
+#include <cstdio>
+#include <random>
+
+// Final disc difference for the side to move, empties going to the winner.
+// Plain fail-hard alpha-beta: no ordering, tables or cutoffs beyond the window.
+static int reference(const Board& board, bool is_black, int alpha, int beta, bool passed) {
+    uint64_t moves = board.get_move_mask(is_black);
+    if (!moves) {
+        if (passed) {
+            const int diff = __builtin_popcountll(board.black) - __builtin_popcountll(board.white);
+            const int empties = 64 - __builtin_popcountll(board.black | board.white);
+            const int score = diff > 0 ? diff + empties : diff < 0 ? diff - empties : 0;
+            return std::max(alpha, std::min(beta, is_black ? score : -score));
+        }
+        return -reference(board, !is_black, -beta, -alpha, true);
+    }
+    for (; moves; moves &= moves - 1) {
+        Board next = board;
+        next.make_move(moves & -moves, is_black);
+        alpha = std::max(alpha, -reference(next, !is_black, -beta, -alpha, false));
+        if (alpha >= beta) break;
+    }
+    return alpha;
+}
+
+static int black_value(int diff_black) {
+    return diff_black > 0 ? INF / 2 + diff_black : diff_black < 0 ? -INF / 2 + diff_black : 0;
+}
+
+static void test_against_minimax(std::mt19937_64& rng) {
+    const int EMPTIES = EndgameCache::MIN_EMPTIES; // cached, and deep enough for the bounds table
+    EndgameCache cache(1 << 20);
+
+    for (int n = 0; n < 20;) {
+        Board board;
+        bool is_black = true;
+        random_game(rng, [&](const Board& b, bool black) {
+            board = b;
+            is_black = black;
+            return 64 - __builtin_popcountll(b.black | b.white) > EMPTIES;
+        });
+        if (64 - __builtin_popcountll(board.black | board.white) != EMPTIES || !board.get_move_mask(is_black)) continue;
+        ++n;
+
+        // Exact score of every root move
+        int scores[64] = {};
+        int score = -64;
+        for (uint64_t moves = board.get_move_mask(is_black); moves; moves &= moves - 1) {
+            Board next = board;
+            next.make_move(moves & -moves, is_black);
+            scores[__builtin_ctzll(moves)] = -reference(next, !is_black, -64, 64, false);
+            score = std::max(score, scores[__builtin_ctzll(moves)]);
+        }
+
+        for (int pass = 0; pass < 2; ++pass) { // the second solve is served from the cache
+            Search search(&cache);
+            SearchResult result = search.iterative_deepening(board, is_black, 60000, 60);
+            CHECK(result.value == black_value(is_black ? score : -score), "value %d, exact score %d", result.value, score);
+            CHECK(board.is_valid_move(result.move, is_black) && scores[__builtin_ctzll(result.move)] == score,
+                  "%s does not reach the exact score", move_to_notation(result.move).c_str());
+        }
+    }
+    CHECK(cache.size() > 0, "nothing was cached");
+}
+
+int main() {
+    std::mt19937_64 rng(31);
+    test_against_minimax(rng);
+
+    return test_result("endgame");
+}
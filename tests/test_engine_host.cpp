@@ -0,0 +1,99 @@
+// EngineHost: session pool limits, admission control, deadlines, book moves
+#include "board.hpp"
+#include "check.hpp"
+#include "engineHost.hpp"
+#include "gameFormat.hpp"
+#include "openingBook.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static steady_clock::time_point in_ms(int ms) {
+    return steady_clock::now() + milliseconds(ms);
+}
+
+static void test_sessions_and_admission() {
+    EngineHostConfig config;
+    config.threads = 1;
+    config.max_sessions = 2;
+    config.tt_mb_per_session = 1;
+    config.queue_capacity = 1;
+    EngineHost host(config);
+
+    const int a = host.open_session();
+    const int b = host.open_session();
+    CHECK(a >= 0 && b >= 0 && a != b, "sessions %d %d", a, b);
+    CHECK(host.open_session() == -1, "pool should be exhausted");
+
+    Board board;
+    auto first = host.request_move(a, board, true, 200, in_ms(5000));
+    // Session a is busy until its search finishes
+    auto again = host.request_move(a, board, true, 10, in_ms(5000));
+    CHECK(again.get().status == REQUEST_REJECTED, "busy session accepted");
+    CHECK(host.request_move(99, board, true, 10, in_ms(5000)).get().status == REQUEST_REJECTED, "unknown session");
+
+    MoveReply reply = first.get();
+    CHECK(reply.status == REQUEST_OK && board.is_valid_move(reply.result.move, true), "search failed");
+
+    // An already missed deadline expires instead of searching
+    CHECK(host.request_move(a, board, true, 10, in_ms(-1)).get().status == REQUEST_EXPIRED, "missed deadline");
+
+    // The deadline cuts the search short
+    const auto start = steady_clock::now();
+    reply = host.request_move(b, board, true, 5000, in_ms(100)).get();
+    const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    CHECK(reply.status == REQUEST_OK && elapsed < 1000, "deadline ignored (%lld ms)", static_cast<long long>(elapsed));
+
+    // A closed slot is reused under a new id; the old id is dead
+    host.close_session(a);
+    const int reopened = host.open_session();
+    CHECK(reopened >= 0 && reopened != a, "closed slot not reused (%d)", reopened);
+    CHECK(host.request_move(a, board, true, 10, in_ms(5000)).get().status == REQUEST_REJECTED, "stale id accepted");
+    host.close_session(a); // must not close the new owner's session
+    CHECK(host.request_move(reopened, board, true, 10, in_ms(5000)).get().status == REQUEST_OK, "new owner rejected");
+}
+
+static void test_book_moves() {
+    const std::string path = temp_path("book");
+    std::vector<uint8_t> squares;
+    {
+        GameFormat::GameWriter writer(path);
+        for (int i = 0; i < 3; ++i) {
+            GameFormat::from_transcript("f5 d6 c3", squares);
+            writer.write(GameFormat::view(squares));
+        }
+        GameFormat::from_transcript("f5 f6", squares);
+        writer.write(GameFormat::view(squares));
+    }
+
+    OpeningBook book;
+    CHECK(book.load_games(path), "book load failed");
+    std::remove(path.c_str());
+
+    Board board;
+    CHECK(book.probe(board, true) == notation_to_move("f5"), "start position");
+    board.make_move(notation_to_move("f5"), true);
+    CHECK(book.probe(board, false) == notation_to_move("d6"), "most frequent reply wins");
+
+    // Symmetric opening d3 is answered with the mirrored reply
+    Board mirrored;
+    mirrored.make_move(notation_to_move("d3"), true);
+    const uint64_t reply = book.probe(mirrored, false);
+    CHECK(reply && mirrored.is_valid_move(reply, false), "mirrored position not found");
+
+    EngineHostConfig config;
+    config.threads = 1;
+    config.max_sessions = 1;
+    config.tt_mb_per_session = 1;
+    EngineHost host(config, &book);
+    const int session = host.open_session();
+    MoveReply answer = host.request_move(session, Board(), true, 100, in_ms(1000)).get();
+    CHECK(answer.status == REQUEST_BOOK && answer.result.move == notation_to_move("f5"), "book move not used");
+}
+
+int main() {
+    test_sessions_and_admission();
+    test_book_moves();
+
+    return test_result("engine host");
+}
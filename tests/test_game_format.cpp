@@ -0,0 +1,135 @@
+// Round trips games and positions through the binary format and transcripts
+#include "board.hpp"
+#include "check.hpp"
+#include "gameFormat.hpp"
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+static void test_games(std::mt19937_64& rng) {
+    const std::string path = temp_path("games");
+    const size_t GAMES = 3 * GameFormat::GAMES_PER_BLOCK + 17; // several blocks, last one partial
+
+    std::vector<std::vector<uint8_t>> games;
+    {
+        GameFormat::GameWriter writer(path);
+        CHECK(writer.is_open(), "cannot create %s", path.c_str());
+        for (size_t i = 0; i < GAMES; ++i) {
+            games.push_back(random_game(rng));
+            writer.write(GameFormat::view(games.back()));
+        }
+        CHECK(writer.close(), "close failed");
+    }
+
+    GameFormat::GameReader reader(path);
+    CHECK(reader.is_open(), "reader rejected file");
+    CHECK(reader.size() == GAMES, "game count %llu", static_cast<unsigned long long>(reader.size()));
+    CHECK(reader.block_count() == 4, "block count %zu", reader.block_count());
+
+    size_t index = 0;
+    reader.for_each([&](GameFormat::GameView game) {
+        const auto& expected = games[index++];
+        CHECK(std::vector<uint8_t>(game.squares, game.squares + game.length) == expected, "game %zu differs", index);
+    });
+    CHECK(index == GAMES, "sequential decode saw %zu games", index);
+
+    // Parallel decode replays every game and compares final boards
+    std::mutex lock;
+    size_t replayed = 0, disc_total = 0;
+    reader.for_each_parallel([&](GameFormat::GameView game) {
+        Board board;
+        const bool ok = GameFormat::replay(game, board);
+        std::lock_guard<std::mutex> guard(lock);
+        CHECK(ok && board.is_game_over(), "replay failed");
+        ++replayed;
+        disc_total += __builtin_popcountll(board.black | board.white);
+    }, 4);
+
+    size_t expected_discs = 0;
+    for (const auto& game : games) expected_discs += 4 + game.size();
+    CHECK(replayed == GAMES, "parallel decode saw %zu games", replayed);
+    CHECK(disc_total == expected_discs, "disc totals differ");
+
+    // Transcripts round trip, with passes and without spaces
+    for (size_t i = 0; i < 200; ++i) {
+        const std::string text = GameFormat::to_transcript(GameFormat::view(games[i]));
+        std::vector<uint8_t> parsed;
+        CHECK(GameFormat::from_transcript(text, parsed) && parsed == games[i], "transcript %zu", i);
+
+        std::string compact;
+        for (char c : text) if (c != ' ') compact += c;
+        CHECK(GameFormat::from_transcript(compact + " pass", parsed) && parsed == games[i], "compact transcript %zu", i);
+    }
+
+    std::vector<uint8_t> parsed;
+    CHECK(!GameFormat::from_transcript("a1", parsed), "illegal opening move accepted");
+    CHECK(!GameFormat::from_transcript("f5 z9", parsed), "garbage accepted");
+    CHECK(GameFormat::from_transcript("F5 d6", parsed) && parsed.size() == 2, "upper case rejected");
+    CHECK(GameFormat::from_transcript("F5 PASS d6 Pass", parsed) && parsed.size() == 2, "upper case pass rejected");
+    CHECK(!GameFormat::from_transcript("f5 pas", parsed), "truncated pass accepted");
+
+    // The writer refuses off-board squares rather than spoil the file
+    const std::string bad_path = temp_path("bad_square");
+    {
+        GameFormat::GameWriter writer(bad_path);
+        const std::vector<uint8_t> bad = {37, 64};
+        CHECK(!writer.write(GameFormat::view(bad)), "square 64 written");
+    }
+    CHECK(GameFormat::GameReader(bad_path).is_open(), "file spoiled by a rejected game");
+    std::remove(bad_path.c_str());
+
+    // A square byte off the board fails the file check, so decoding never sees it
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(GameFormat::FileHeader) + sizeof(GameFormat::BlockHeader) + 1);
+        file.put(static_cast<char>(64));
+    }
+    CHECK(!GameFormat::GameReader(path).is_open(), "square byte 64 accepted");
+
+    std::remove(path.c_str());
+}
+
+static void test_positions(std::mt19937_64& rng) {
+    const std::string path = temp_path("positions");
+    std::vector<GameFormat::PositionRecord> expected;
+    {
+        GameFormat::PositionWriter writer(path);
+        for (int g = 0; g < 500; ++g) {
+            const auto game = random_game(rng);
+            Board board;
+            GameFormat::replay(GameFormat::view(game), board, [&](const Board& b, bool is_black, uint64_t move) {
+                writer.write(b, is_black, static_cast<int>(rng() % 129) - 64, move, 1 + rng() % 20);
+            });
+        }
+        CHECK(writer.close(), "close failed");
+    }
+
+    GameFormat::PositionReader reader(path);
+    CHECK(reader.is_open(), "reader rejected file");
+    size_t legal = 0;
+    for (const auto& record : reader) {
+        Board board;
+        board.black = record.black;
+        board.white = record.white;
+        legal += board.is_valid_move(1ULL << record.best_square, record.black_to_move);
+    }
+    CHECK(legal == reader.size(), "%zu of %llu stored moves are legal", legal,
+          static_cast<unsigned long long>(reader.size()));
+
+    std::atomic<uint64_t> seen{0};
+    reader.for_each_parallel([&](const GameFormat::PositionRecord&) { ++seen; }, 3);
+    CHECK(seen == reader.size(), "parallel visit count");
+
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::mt19937_64 rng(2024);
+    test_games(rng);
+    test_positions(rng);
+
+    return test_result("game format");
+}
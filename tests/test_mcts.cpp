@@ -0,0 +1,78 @@
+// MCTS engine: legal moves from random positions, tree reuse between moves
+#include "board.hpp"
+#include "check.hpp"
+#include "mcts.hpp"
+#include <cstdio>
+#include <random>
+
+static void test_legal_moves(std::mt19937_64& rng) {
+    MCTSConfig config;
+    config.threads = 3;
+    config.max_nodes = 1 << 16; // small arena: exercises the arena-full path
+    MCTS mcts(config);
+
+    for (int game = 0; game < 6; ++game) {
+        Board board;
+        bool is_black = true;
+        while (!board.is_game_over()) {
+            if (!board.get_move_mask(is_black)) {
+                is_black = !is_black;
+                continue;
+            }
+            SearchResult result = mcts.search(board, is_black, 5);
+            CHECK(board.is_valid_move(result.move, is_black), "illegal move %s", move_to_notation(result.move).c_str());
+            CHECK(result.value >= -1000 && result.value <= 1000, "value %d out of range", result.value);
+            if (!board.is_valid_move(result.move, is_black)) return;
+
+            // Mix in random moves so the tree is not always reusable
+            auto moves = board.get_moves(is_black);
+            board.make_move(rng() % 3 ? result.move : moves[rng() % moves.size()], is_black);
+            is_black = !is_black;
+        }
+    }
+}
+
+static void test_tree_reuse() {
+    MCTSConfig config;
+    config.threads = 2;
+    MCTS mcts(config);
+
+    Board board;
+    SearchResult first = mcts.search(board, true, 50);
+    const size_t nodes_before = mcts.nodes_used();
+    board.make_move(first.move, true);
+
+    // The reply position is a child of the old root, so the arena keeps growing
+    mcts.search(board, false, 20);
+    CHECK(mcts.nodes_used() > nodes_before, "tree was not reused (%zu -> %zu)", nodes_before, mcts.nodes_used());
+
+    // An unrelated position starts a fresh tree
+    Board other;
+    other.black = 0x0000001818000000ULL; // not reachable from the old root
+    other.white = 0x0000240000240000ULL;
+    mcts.search(other, false, 5);
+    CHECK(mcts.nodes_used() < nodes_before, "arena was not recycled");
+}
+
+static void test_finds_winning_move() {
+    // Black to move with 8 empties: of a1, b5, a6 and a7 only a1 wins
+    // (checked by exhaustive search)
+    Board board;
+    board.black = 0x40F0E8C06858007CULL;
+    board.white = 0x9F0E163D17A77F02ULL;
+    CHECK(board.get_moves(true).size() == 4, "expected four legal moves");
+
+    MCTS mcts;
+    SearchResult result = mcts.search(board, true, 100);
+    CHECK(result.move == notation_to_move("a1"), "expected a1, got %s", move_to_notation(result.move).c_str());
+    CHECK(result.value > 0, "winning move valued %d", result.value);
+}
+
+int main() {
+    std::mt19937_64 rng(99);
+    test_legal_moves(rng);
+    test_tree_reuse();
+    test_finds_winning_move();
+
+    return test_result("mcts");
+}
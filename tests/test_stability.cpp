@@ -0,0 +1,115 @@
+// Checks Stability::stable_discs against a brute-force search over every
+// position reachable from small endgames.
+#include "board.hpp"
+#include "check.hpp"
+#include "stability.hpp"
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+
+// Play random moves from the start until `empties` squares are left
+static bool random_position(std::mt19937_64& rng, int empties, Board& board) {
+    bool reached = false;
+    random_game(rng, [&](const Board& b, bool) {
+        board = b;
+        reached = 64 - __builtin_popcountll(b.black | b.white) <= empties;
+        return !reached;
+    });
+    return reached;
+}
+
+// Explore every position reachable by legal moves of either color in any
+// order (a superset of real games) and collect the original player discs
+// that get flipped somewhere. Everything else is truly stable.
+static void explore(uint64_t player, uint64_t opponent, uint64_t original,
+                    std::set<std::pair<uint64_t, uint64_t>>& seen, uint64_t& flipped) {
+    if (!seen.insert({player, opponent}).second) return;
+    flipped |= original & ~player;
+
+    for (int side = 0; side < 2; ++side) {
+        Board board;
+        board.black = player;
+        board.white = opponent;
+        const bool is_black = side == 0;
+        uint64_t moves = board.get_move_mask(is_black);
+        while (moves) {
+            uint64_t move = moves & -moves;
+            moves ^= move;
+            Board next = board;
+            next.make_move(move, is_black);
+            explore(next.black, next.white, original, seen, flipped);
+        }
+    }
+}
+
+static uint64_t brute_force_stable(uint64_t player, uint64_t opponent) {
+    std::set<std::pair<uint64_t, uint64_t>> seen;
+    uint64_t flipped = 0;
+    explore(player, opponent, player, seen, flipped);
+    return player & ~flipped;
+}
+
+static void test_full_lines(std::mt19937_64& rng) {
+    for (int i = 0; i < 100000; ++i) {
+        const uint64_t occupied = rng() | rng() | rng(); // dense boards have full lines
+        const auto full = Stability::full_lines(occupied);
+        const uint64_t axes[4] = {full.horizontal, full.vertical, full.diagonal, full.anti_diagonal};
+        const int dirs[4] = {Tables::RIGHT, Tables::DOWN, Tables::DOWN_RIGHT, Tables::DOWN_LEFT};
+        const int opposites[4] = {Tables::LEFT, Tables::UP, Tables::UP_LEFT, Tables::UP_RIGHT};
+
+        for (int sq = 0; sq < 64; ++sq) {
+            for (int axis = 0; axis < 4; ++axis) {
+                const uint64_t line = Tables::RAYS[dirs[axis]][sq] | Tables::RAYS[opposites[axis]][sq] | (1ULL << sq);
+                const bool expected = (occupied & line) == line;
+                CHECK(((axes[axis] >> sq) & 1) == expected, "full line axis %d square %d", axis, sq);
+            }
+        }
+    }
+}
+
+static void test_against_brute_force(std::mt19937_64& rng) {
+    int positions = 0, kernel_total = 0, exact_total = 0;
+    for (int i = 0; i < 3000; ++i) {
+        const int empties = 1 + static_cast<int>(rng() % 7);
+        Board board;
+        if (!random_position(rng, empties, board)) continue;
+
+        for (int side = 0; side < 2; ++side) {
+            const uint64_t player = side ? board.white : board.black;
+            const uint64_t opponent = side ? board.black : board.white;
+            const uint64_t stable = Stability::stable_discs(player, opponent);
+            const uint64_t exact = brute_force_stable(player, opponent);
+
+            CHECK((stable & ~player) == 0, "stable discs outside player");
+            CHECK((stable & ~exact) == 0, "unstable disc reported stable: player %016llx opponent %016llx",
+                  static_cast<unsigned long long>(player), static_cast<unsigned long long>(opponent));
+            kernel_total += __builtin_popcountll(stable);
+            exact_total += __builtin_popcountll(exact);
+        }
+        ++positions;
+    }
+    CHECK(positions > 1000, "too few test positions (%d)", positions);
+    printf("%d positions, kernel finds %d of %d stable discs\n", positions, kernel_total, exact_total);
+}
+
+static void test_known_positions() {
+    // Corners and full edges
+    CHECK(Stability::stable_discs(0x8100000000000081ULL, 0) == 0x8100000000000081ULL, "corners");
+    CHECK(Stability::stable_discs(0x00000000000000FFULL, 0) == 0x00000000000000FFULL, "edge from corner");
+    CHECK(Stability::stable_discs(0x000000000000007EULL, 0) == 0, "edge without corner");
+    // Full board: everything is stable
+    CHECK(Stability::stable_discs(0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL) == 0x5555555555555555ULL, "full board");
+    // Opening position: nothing is stable
+    Board start;
+    CHECK(Stability::stable_discs(start.black, start.white) == 0, "start position");
+}
+
+int main() {
+    std::mt19937_64 rng(12345);
+    test_known_positions();
+    test_full_lines(rng);
+    test_against_brute_force(rng);
+
+    return test_result("stability");
+}
@@ -1,9 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <exception>
+#include <fstream>
+#include <new>
+#include <string>
+#include <thread>
 #include <vector>
 #include <limits>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 
 enum EntryType : uint8_t {
@@ -23,21 +33,81 @@ struct TTEntry {
 };
 
 
+enum NumaPolicy : uint8_t {
+    NUMA_LOCAL,      // one slice per node, first-touched by a thread pinned to that node
+    NUMA_INTERLEAVE  // pages round-robin over all nodes
+};
+
+struct TTConfig {
+    size_t size_mb = 32;          // rounded down to a power-of-two entry count
+    bool huge_pages = true;       // 2 MB pages when available, regular pages otherwise
+    NumaPolicy numa = NUMA_LOCAL;
+    unsigned clear_threads = 0;   // 0 = one per hardware thread
+};
+
+
 class TranspositionTable {
-    static constexpr size_t TABLE_SIZE = 1 << 20; // 1M entries
     static constexpr uint64_t KEY_MASK = 0xFFFFFFFFFFFF0000;
-    std::vector<TTEntry> table;
+    static constexpr size_t HUGE_PAGE_SIZE = 2 << 20;
+    static constexpr int MPOL_INTERLEAVE_MODE = 3; // MPOL_INTERLEAVE from <numaif.h>
+
+    TTEntry* table = nullptr;
+    size_t table_size = 0;   // entries, power of two
+    size_t mapped_bytes = 0;
+    bool huge = false;
+    unsigned clear_threads;
     uint8_t current_generation = 0;
 
 public:
-    TranspositionTable() : table(TABLE_SIZE) {}
-    
+    explicit TranspositionTable(const TTConfig& config = TTConfig{}) {
+        table_size = 1;
+        while (table_size * 2 * sizeof(TTEntry) <= (config.size_mb << 20)) table_size *= 2;
+        mapped_bytes = (table_size * sizeof(TTEntry) + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        clear_threads = config.clear_threads ? config.clear_threads : std::max(1u, std::thread::hardware_concurrency());
+
+        allocate(config.huge_pages);
+        // Fresh anonymous mappings are already zero; on a single node there is
+        // nothing to place either, so the pages are faulted in by the search
+        const std::vector<int> nodes = online_nodes();
+        if (nodes.size() >= 2) {
+            if (config.numa == NUMA_INTERLEAVE) interleave(nodes);
+            else first_touch(nodes);
+        }
+    }
+
+    ~TranspositionTable() {
+        munmap(table, mapped_bytes);
+    }
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    size_t size() const { return table_size; }
+    size_t memory_bytes() const { return mapped_bytes; }
+    bool uses_huge_pages() const { return huge; }
+
+    // Zero the table in parallel slices. Pages keep the node they were
+    // placed on at construction.
     void clear() {
-        std::fill(table.begin(), table.end(), TTEntry{});
+        const size_t bytes = table_size * sizeof(TTEntry);
+        const unsigned threads = static_cast<unsigned>(std::min<size_t>(clear_threads, bytes / HUGE_PAGE_SIZE + 1));
+        const size_t slice = (bytes / threads + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        auto* memory = reinterpret_cast<unsigned char*>(table);
+
+        auto worker = [=](unsigned t) {
+            const size_t begin = std::min(bytes, t * slice);
+            const size_t end = std::min(bytes, begin + slice);
+            std::memset(memory + begin, 0, end - begin);
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& thread : pool) thread.join();
     }
     
     void store(uint64_t hash, int depth, int value, EntryType type, uint64_t best_move) {
-        TTEntry& entry = table[hash % TABLE_SIZE];
+        TTEntry& entry = table[hash & (table_size - 1)];
         if (entry.depth <= depth || entry.generation != current_generation) {
             entry = {
                 hash & KEY_MASK,
@@ -51,7 +121,7 @@ public:
     }
     
     bool probe(uint64_t hash, int depth, int& alpha, int& beta, int& value, uint64_t& best_move) const {
-        const TTEntry& entry = table[hash % TABLE_SIZE];
+        const TTEntry& entry = table[hash & (table_size - 1)];
         
         if ((entry.key ^ hash) & KEY_MASK) return false;
         if (entry.depth == 0 && entry.type == EXACT && entry.value == 0) return false;
@@ -78,9 +148,93 @@ public:
         return false;
     }
     
+    // Stored best move for a position, 0 if the slot holds another position
+    uint64_t best_move(uint64_t hash) const {
+        const TTEntry& entry = table[hash & (table_size - 1)];
+        if ((entry.key ^ hash) & KEY_MASK) return 0;
+        return entry.best_move;
+    }
+
     void new_search() {
         current_generation = (current_generation + 1) % 256; // 0-255
     }
+
+private:
+    // Explicit 2 MB pages (MAP_HUGETLB) need a reserved pool; otherwise ask for
+    // transparent huge pages, and plain 4 KB pages if neither is available
+    void allocate(bool want_huge) {
+        void* memory = MAP_FAILED;
+        if (want_huge) {
+            memory = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            huge = memory != MAP_FAILED;
+        }
+        if (memory == MAP_FAILED) {
+            memory = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) throw std::bad_alloc();
+            if (want_huge) huge = madvise(memory, mapped_bytes, MADV_HUGEPAGE) == 0;
+        }
+        table = static_cast<TTEntry*>(memory);
+    }
+
+    // sysfs list format: "0" or "0-3" or "0-1,4-5"
+    static std::vector<int> read_list(const std::string& path) {
+        std::ifstream in(path);
+        std::string ranges;
+        std::vector<int> values;
+        if (!(in >> ranges)) return values;
+
+        size_t pos = 0;
+        while (pos < ranges.size()) {
+            size_t next = ranges.find(',', pos);
+            if (next == std::string::npos) next = ranges.size();
+            const std::string range = ranges.substr(pos, next - pos);
+            const size_t dash = range.find('-');
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int value = first; value <= last; ++value) values.push_back(value);
+            pos = next + 1;
+        }
+        return values;
+    }
+
+    static std::vector<int> online_nodes() {
+        return read_list("/sys/devices/system/node/online");
+    }
+
+    // Interleave pages over every online NUMA node
+    void interleave(const std::vector<int>& nodes) {
+        unsigned long nodemask = 0;
+        for (int node : nodes) {
+            if (node < 64) nodemask |= 1UL << node;
+        }
+        syscall(SYS_mbind, table, mapped_bytes, MPOL_INTERLEAVE_MODE, &nodemask, 8 * sizeof(nodemask) + 1, 0);
+    }
+
+    // Split the table into one huge-page-aligned slice per node and fault each
+    // slice in from a thread pinned to that node's CPUs, so under the default
+    // local-allocation policy every slice lives on its own node
+    void first_touch(const std::vector<int>& nodes) {
+        const size_t slice = (mapped_bytes / nodes.size() + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        auto* memory = reinterpret_cast<unsigned char*>(table);
+
+        auto worker = [=](size_t index) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (int cpu : read_list("/sys/devices/system/node/node" + std::to_string(nodes[index]) + "/cpulist")) {
+                if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpus);
+            }
+            if (CPU_COUNT(&cpus)) sched_setaffinity(0, sizeof(cpus), &cpus); // this thread only
+
+            const size_t begin = std::min(mapped_bytes, index * slice);
+            const size_t end = std::min(mapped_bytes, begin + slice);
+            std::memset(memory + begin, 0, end - begin);
+        };
+
+        std::vector<std::thread> pool;
+        for (size_t i = 0; i < nodes.size(); ++i) pool.emplace_back(worker, i);
+        for (auto& thread : pool) thread.join();
+    }
 };
 
 
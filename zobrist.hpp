@@ -5,39 +5,43 @@
 #include <array>
 #include <cstdint>
 #include <sys/types.h>
-#include <random>
 
 namespace Zobrist {
     struct Lehmer64 {
         uint64_t state;
-        constexpr Lehmer64(uint64_t seed) : state(seed) {}
+        constexpr Lehmer64(uint64_t seed) : state(seed | 1) {} // multiplicative: state must be odd
         constexpr uint64_t next() {
-            state = (state * 0xda942042e4dd58b5ULL); // 64-bit Lehmer multiplicative PRNG
-            return state;
+            // 64-bit Lehmer multiplicative PRNG. The low bits of the state are
+            // weak (and the TT indexes by them), so combine two high halves.
+            state = (state * 0xda942042e4dd58b5ULL);
+            const uint64_t hi = state >> 32;
+            state = (state * 0xda942042e4dd58b5ULL);
+            return (hi << 32) | (state >> 32);
         }
     };
 
-    inline auto generate_zobrist_data() {
-        struct {
-            std::array<std::array<uint64_t, 2>, 64> squares;
-            uint64_t black_to_move;
-        } data;
+    struct ZobristData {
+        std::array<std::array<uint64_t, 2>, 64> squares;
+        uint64_t black_to_move;
+    };
 
+    constexpr ZobristData generate_zobrist_data() {
         static_assert(sizeof(uint64_t) == 8, "Zobrist requires 64-bit system");
-        std::mt19937_64 rng(0xDEADBEEF);  // Fixed seed for reproducibility
-        
+        ZobristData data{};
+        Lehmer64 rng(0xDEADBEEF);  // Fixed seed for reproducibility
+
         for (auto& square : data.squares) {
-            square[0] = rng();  // Black pieces
-            square[1] = rng();  // White pieces
+            square[0] = rng.next();  // Black pieces
+            square[1] = rng.next();  // White pieces
         }
-        data.black_to_move = rng();
+        data.black_to_move = rng.next();
         return data;
     }
 
 
-    inline const auto zobrist_data = generate_zobrist_data();
-    inline const auto& zobrist_table = zobrist_data.squares;
-    inline const auto black_to_move_key = zobrist_data.black_to_move;
+    alignas(64) inline constexpr ZobristData zobrist_data = generate_zobrist_data();
+    inline constexpr const auto& zobrist_table = zobrist_data.squares;
+    inline constexpr uint64_t black_to_move_key = zobrist_data.black_to_move;
 
 
     inline uint64_t compute_hash(const Board& board, bool is_black_turn) {
@@ -64,4 +68,34 @@ namespace Zobrist {
         }
         return hash;
     }
+
+    // Hash after a move (or pass) from the hash before it: toggles every
+    // square that changed colour and the side to move
+    inline uint64_t update_hash(uint64_t hash, const Board& before, const Board& after) {
+        for (uint64_t changed = before.black ^ after.black; changed; changed &= changed - 1) {
+            hash ^= zobrist_table[__builtin_ctzll(changed)][0];
+        }
+        for (uint64_t changed = before.white ^ after.white; changed; changed &= changed - 1) {
+            hash ^= zobrist_table[__builtin_ctzll(changed)][1];
+        }
+        return hash ^ black_to_move_key;
+    }
+
+    // Smallest hash of the side-to-move/opponent discs over the 8 board
+    // symmetries, and the symmetry that produced it. Mirrored and
+    // color-swapped positions share a key.
+    inline uint64_t canonical_hash(uint64_t player, uint64_t opponent, int& sym) {
+        uint64_t best = ~0ULL;
+        for (int s = 0; s < 8; ++s) {
+            Board b;
+            b.black = Board::transform(player, s);
+            b.white = Board::transform(opponent, s);
+            uint64_t hash = compute_hash(b, true);
+            if (hash < best) {
+                best = hash;
+                sym = s;
+            }
+        }
+        return best;
+    }
 }
\ No newline at end of file